@@ -0,0 +1,171 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RomBundle.hpp"
+
+#include <cstdio>
+#include <cstring>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static uint64_t align_8(uint64_t offset) {
+    return (offset + 7U) & ~uint64_t(7U);
+}
+
+bool write_rom_bundle(const char * filename, const std::vector<CRomGeneratorRuntime> & roms) {
+    FILE * bundle_file = fopen(filename, "wb");
+    if (!bool(bundle_file)) {
+        perror("Can't open the rom bundle for writing.");
+        return false;
+    }
+
+    rcr::rom_bundle_header header {};
+    memcpy(header.magic, rcr::rom_bundle_magic, sizeof(header.magic));
+    header.version = rcr::rom_bundle_version;
+    header.count   = uint32_t(roms.size());
+
+    std::vector<rcr::rom_bundle_entry> index(roms.size());
+
+    uint64_t offset = align_8(sizeof(header) + roms.size() * sizeof(rcr::rom_bundle_entry));
+    for (size_t i = 0; i < roms.size(); i++) {
+        index[i].type      = uint8_t(roms[i].type);
+        index[i].In_W      = uint8_t(roms[i].In_W);
+        index[i].nb_stages = uint8_t(roms[i].nb_stages);
+        index[i].reserved  = 0;
+        index[i].q         = roms[i].q;
+        index[i].divider   = roms[i].divider;
+        index[i].length    = roms[i].max_length;
+        index[i].offset    = offset;
+
+        offset = align_8(offset + roms[i].max_length);
+    }
+
+    bool ok = fwrite(&header, sizeof(header), 1, bundle_file) == 1;
+    ok      = ok && (index.empty() || fwrite(index.data(), sizeof(rcr::rom_bundle_entry), index.size(), bundle_file) == index.size());
+
+    const uint8_t padding[8] = {0};
+    uint64_t      position   = sizeof(header) + index.size() * sizeof(rcr::rom_bundle_entry);
+    for (size_t i = 0; ok && i < roms.size(); i++) {
+        ok       = fwrite(padding, 1, index[i].offset - position, bundle_file) == index[i].offset - position;
+        ok       = ok && fwrite(roms[i].rom.data(), 1, roms[i].max_length, bundle_file) == roms[i].max_length;
+        position = index[i].offset + roms[i].max_length;
+    }
+
+    if (fclose(bundle_file) != 0 || !ok) {
+        perror("Can't write the rom bundle.");
+        return false;
+    }
+    return true;
+}
+
+bool CRomBundle::open(const char * filename) {
+    close();
+
+#if defined(_WIN32)
+    FILE * bundle_file = fopen(filename, "rb");
+    if (!bool(bundle_file)) {
+        perror("Can't open the rom bundle.");
+        return false;
+    }
+    fseek(bundle_file, 0, SEEK_END);
+    buffer.resize(size_t(ftell(bundle_file)));
+    fseek(bundle_file, 0, SEEK_SET);
+    const bool read_ok = fread(buffer.data(), 1, buffer.size(), bundle_file) == buffer.size();
+    fclose(bundle_file);
+    if (!read_ok) {
+        perror("Can't read the rom bundle.");
+        return false;
+    }
+    base   = buffer.data();
+    length = buffer.size();
+#else
+    const int fd = ::open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Can't open the rom bundle.");
+        return false;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        perror("Can't stat the rom bundle.");
+        ::close(fd);
+        return false;
+    }
+
+    void * mapping = mmap(nullptr, size_t(file_stat.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        perror("Can't map the rom bundle.");
+        return false;
+    }
+    base   = static_cast<const uint8_t *>(mapping);
+    length = size_t(file_stat.st_size);
+#endif
+
+    bool valid = length >= sizeof(rcr::rom_bundle_header)
+              && memcmp(header().magic, rcr::rom_bundle_magic, sizeof(rcr::rom_bundle_magic)) == 0
+              && header().version == rcr::rom_bundle_version
+              && sizeof(rcr::rom_bundle_header) + uint64_t(header().count) * sizeof(rcr::rom_bundle_entry) <= length;
+
+    for (uint32_t i = 0; valid && i < header().count; i++) {
+        const rcr::rom_bundle_entry & entry = entries()[i];
+        valid                               = entry.offset % 8 == 0
+             && entry.offset <= length && entry.length <= length - entry.offset
+             && entry.length == rcr::rom_length(entry.q, entry.divider)
+             && CRomGeneratorRuntime::valid_parameters(entry.In_W, entry.nb_stages, entry.q, entry.divider);
+    }
+
+    if (!valid) {
+        fprintf(stderr, "%s is not a valid version %u CORDIC rom bundle.\n", filename, rcr::rom_bundle_version);
+        close();
+        return false;
+    }
+    return true;
+}
+
+void CRomBundle::close() {
+#if defined(_WIN32)
+    buffer.clear();
+#else
+    if (base != nullptr) {
+        munmap(const_cast<uint8_t *>(base), length);
+    }
+#endif
+    base   = nullptr;
+    length = 0;
+}
+
+const rcr::rom_bundle_entry * CRomBundle::find(rcr::generator_type type, unsigned In_W, unsigned nb_stages, unsigned q, unsigned divider) const {
+    for (uint32_t i = 0; i < size(); i++) {
+        const rcr::rom_bundle_entry & entry = entries()[i];
+        if (entry.type == uint8_t(type)
+            && entry.In_W == In_W
+            && entry.nb_stages == nb_stages
+            && entry.q == q
+            && entry.divider == divider) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,119 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ROM_BUNDLE_HPP_
+#define _ROM_BUNDLE_HPP_
+
+#if __cplusplus >= 201402L || XILINX_MAJOR > 2019
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "RomGeneratorRuntime/RomGeneratorRuntime.hpp"
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @file RomBundle.hpp
+ * Binary bundle holding many CORDIC ROMs, meant to be mapped in memory at runtime.
+ *
+ * Layout (native endianness, every ROM 8-bytes aligned):
+ * | rom_bundle_header | rom_bundle_entry[count] | ROM words... |
+ */
+
+namespace rom_cordic_rotate {
+
+constexpr char     rom_bundle_magic[8] = {'C', 'O', 'R', 'D', 'R', 'O', 'M', 'B'};
+constexpr uint32_t rom_bundle_version  = 1;
+
+struct rom_bundle_header {
+    char     magic[8];
+    uint32_t version;
+    uint32_t count;
+};
+
+struct rom_bundle_entry {
+    uint8_t  type; // generator_type
+    uint8_t  In_W;
+    uint8_t  nb_stages;
+    uint8_t  reserved;
+    uint32_t q;
+    uint32_t divider;
+    uint32_t length;
+    uint64_t offset; // from the start of the file
+};
+
+static_assert(sizeof(rom_bundle_header) == 16, "Unexpected padding in rom_bundle_header.");
+static_assert(sizeof(rom_bundle_entry) == 24, "Unexpected padding in rom_bundle_entry.");
+
+} // namespace rom_cordic_rotate
+
+/// Write every ROM of `roms` in a single bundle, returns false on I/O error.
+bool write_rom_bundle(const char * filename, const std::vector<CRomGeneratorRuntime> & roms);
+
+/**
+ * @brief Read-only memory mapping of a ROM bundle.
+ *
+ * The ROMs handed out by `rom` point directly into the mapping and stay valid until
+ * the bundle is closed or destroyed.
+ */
+class CRomBundle {
+    const uint8_t * base   = nullptr;
+    size_t          length = 0;
+#if defined(_WIN32)
+    std::vector<uint8_t> buffer;
+#endif
+
+    const rcr::rom_bundle_header & header() const {
+        return *reinterpret_cast<const rcr::rom_bundle_header *>(base);
+    }
+
+public:
+    CRomBundle() = default;
+    explicit CRomBundle(const char * filename) { open(filename); }
+
+    CRomBundle(const CRomBundle &) = delete;
+    CRomBundle & operator=(const CRomBundle &) = delete;
+
+    ~CRomBundle() { close(); }
+
+    /// Map `filename` and validate its header and index, returns false (and stays closed) on error.
+    bool open(const char * filename);
+    void close();
+
+    bool is_open() const { return base != nullptr; }
+
+    uint32_t size() const { return is_open() ? header().count : 0; }
+
+    const rcr::rom_bundle_entry * entries() const {
+        return reinterpret_cast<const rcr::rom_bundle_entry *>(base + sizeof(rcr::rom_bundle_header));
+    }
+
+    /// Returns nullptr if the configuration is not part of the bundle.
+    const rcr::rom_bundle_entry * find(rcr::generator_type type, unsigned In_W, unsigned nb_stages, unsigned q, unsigned divider) const;
+
+    const uint8_t * rom(const rcr::rom_bundle_entry & entry) const {
+        return base + entry.offset;
+    }
+};
+
+#endif // STANDARD GUARD
+#endif // _ROM_BUNDLE_HPP_
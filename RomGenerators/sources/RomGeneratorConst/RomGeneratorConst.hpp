@@ -31,6 +31,105 @@
 #include <cassert>
 
 #include "RomRotateCommon/definitions.hpp"
+#include "RomRotateCommon/emitters.hpp"
+
+namespace rom_cordic_rotate {
+
+/**
+ * @brief Compute the control word (sign bits) of a `nb_stages` CORDIC rotating by `rot_in`.
+ *
+ * Bit 0 holds the pi-rotation flag, bit u the direction of stage u.
+ * The word does not depend on the input width, only on the angle and the stage count.
+ */
+constexpr uint8_t cst_rom_entry(unsigned nb_stages, double rot_in) {
+
+    uint8_t       R        = 0;
+    const uint8_t sig_mask = 0x01;
+
+    double beta = rot_in;
+
+    if ((beta < -two_pi) || (two_pi <= beta)) {
+        fprintf(stderr, "rotation must be inside ] -2*pi; 2*pi ]");
+        exit(EXIT_FAILURE);
+    }
+
+    if ((beta <= -pi) || (beta > pi)) {
+        beta = beta < 0. ? beta + two_pi : beta - two_pi;
+    }
+
+    if ((beta < -half_pi) || (beta > half_pi)) {
+        R    = R | sig_mask;
+        beta = beta < 0 ? beta + pi : beta - pi;
+    } else {
+        R = R & (~sig_mask);
+    }
+
+    for (uint8_t u = 1; u < nb_stages + 1; u++) {
+        const uint8_t mask  = (1U << u);
+        const uint8_t nmask = ~mask;
+
+        assert((mask & nmask) == 0x00);
+        assert((mask | nmask) == 0xFF);
+
+        const double sigma = beta < 0 ? -1. : 1;
+
+        R = beta < 0 ? R | mask : R & nmask;
+
+        beta = beta - sigma * atan_values[u - 1];
+    }
+
+    return R;
+}
+
+/// Taylor series of sin, for the angles of a few CORDIC microrotations (no constexpr std::sin in C++14).
+constexpr double cst_sin(double x) {
+    double term = x;
+    double sum  = x;
+    for (unsigned n = 1; n < 16; n++) {
+        term = -term * x * x / double((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr double cst_cos(double x) {
+    double term = 1.;
+    double sum  = 1.;
+    for (unsigned n = 1; n < 16; n++) {
+        term = -term * x * x / double((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr int64_t cst_round(double x) {
+    return x < 0. ? -int64_t(-x + 0.5) : int64_t(x + 0.5);
+}
+
+/**
+ * @brief Compute the gain correction of the control word chosen for `rot_in`.
+ *
+ * The correction `kn * exp(j * (rot_in - rom_angle(R)))`, on `gain_frac` fractional bits,
+ * compensates both the CORDIC gain and the residual angle of the control word.
+ */
+constexpr void cst_rom_gain(unsigned nb_stages, double rot_in, unsigned gain_frac, int64_t & gain_re, int64_t & gain_im) {
+    const uint8_t R = cst_rom_entry(nb_stages, rot_in);
+
+    double residual = rot_in - rom_angle(R, nb_stages);
+    while (residual > pi) {
+        residual -= two_pi;
+    }
+    while (residual <= -pi) {
+        residual += two_pi;
+    }
+
+    const double scale = kn_values[nb_stages - 1] * double(int64_t(1) << gain_frac);
+
+    gain_re = cst_round(cst_cos(residual) * scale);
+    gain_im = cst_round(cst_sin(residual) * scale);
+}
+
+} // namespace rom_cordic_rotate
 
 namespace rcr = rom_cordic_rotate;
 
@@ -39,13 +138,13 @@ class CRomGeneratorConst {
     static_assert(In_W > 0, "Inputs can't be on zero bits.");
     static_assert(NStages < 8, "7 stages of CORDIC is the maximum supported.");
     static_assert(NStages > 1, "2 stages of CORDIC is the minimum.");
-    static_assert(rcr::is_pow_2<divider>(), "divider must be a power of 2.");
+    static_assert(Tq > 0, "q can't be zero.");
 
 public:
-    static constexpr double rotation = rcr::pi / divider;
+    static constexpr double rotation = rcr::rom_rotation(divider);
     static constexpr double q        = Tq;
 
-    static constexpr unsigned max_length   = 2 * divider * Tq; // 2pi / (pi / divider) * q
+    static constexpr unsigned max_length   = unsigned(rcr::rom_length(Tq, divider));
     static constexpr unsigned addr_length  = rcr::needed_bits<max_length - 1>();
     static constexpr int64_t  scale_factor = int64_t(1U << (In_W - 1));
 
@@ -58,128 +157,78 @@ public:
         0.00000095367432, 0.00000047683716, 0.00000023841858, 0.00000011920929,
         0.00000005960464, 0.00000002980232, 0.00000001490116, 0.00000000745058};
 
-private:
-    constexpr uint8_t cordic_rom_gen(double rot_in) const {
-
-        double A = scale_factor - 1;
-        double B = 0;
-
-        uint8_t       R        = 0;
-        const uint8_t sig_mask = 0x01;
-
-        double beta = rot_in;
-
-#if 0
-        printf("Step 0 - %03u : %02x : %8lf\n", R, R, beta);
-#endif
-        if ((beta < -rcr::two_pi) || (rcr::two_pi <= beta)) {
-            fprintf(stderr, "rotation must be inside ] -2*pi; 2*pi ]");
-            exit(EXIT_FAILURE);
-        }
-
-        if ((beta <= -rcr::pi) || (beta > rcr::pi)) {
-            beta = beta < 0. ? beta + rcr::two_pi : beta - rcr::two_pi;
-        }
+    uint8_t rom[max_length];
 
-        if ((beta < -rcr::half_pi) || (beta > rcr::half_pi)) {
-            R    = R | sig_mask;
-            beta = beta < 0 ? beta + rcr::pi : beta - rcr::pi;
-            // A    = -A;
-            // B    = -B;
-        } else {
-            R = R & (~sig_mask);
+    constexpr CRomGeneratorConst() : rom() {
+        for (unsigned n = 0; n < max_length; n++) {
+            const double chip_rotation = rotation / double(q) * double(n);
+            rom[n]                     = rcr::cst_rom_entry(NStages, chip_rotation);
         }
+    }
+};
 
-        for (uint8_t u = 1; u < NStages + 1; u++) {
-#if 0
-            printf("Step %d - %03u : %02x : %8lf\n", u, R, R, beta);
-#endif
-            const uint8_t mask  = (1U << u);
-            const uint8_t nmask = ~mask;
-
-            assert((mask & nmask) == 0x00);
-            assert((mask | nmask) == 0xFF);
-
-            const double sigma = beta < 0 ? -1. : 1;
-
-            R = beta < 0 ? R | mask : R & nmask;
-
-            const double factor = sigma / double(1LU << (u - 1));
+/**
+ * @brief Per-address gain correction of a `CRomGeneratorConst` ROM.
+ *
+ * Applied to the CORDIC outputs as a complex product, it replaces `scale_cordic`
+ * and removes the residual angle error of each control word.
+ */
+template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
+class CRomGainConst {
+public:
+    static constexpr double rotation = rcr::rom_rotation(divider);
+    static constexpr double q        = Tq;
 
-            const double I = A + B * factor;
-            B              = B - A * factor;
-            A              = I;
+    static constexpr unsigned max_length = unsigned(rcr::rom_length(Tq, divider));
+    static constexpr unsigned gain_frac  = In_W + 1;
 
-            beta = beta - sigma * atanDbl[u - 1];
-        }
-#if 0
-        printf("\nFINAL - %03u : %02x : %8lf\n\n", R, R, beta);
-#endif
-        return R;
-    }
+    typedef typename rcr::least_int<rcr::gain_bits(gain_frac)>::type gain_t;
 
-public:
-    uint8_t rom[max_length];
+    gain_t gain_re[max_length];
+    gain_t gain_im[max_length];
 
-    constexpr CRomGeneratorConst() : rom() {
+    constexpr CRomGainConst() : gain_re(), gain_im() {
         for (unsigned n = 0; n < max_length; n++) {
             const double chip_rotation = rotation / double(q) * double(n);
-            rom[n]                     = cordic_rom_gen(chip_rotation);
+
+            int64_t re = 0, im = 0;
+            rcr::cst_rom_gain(NStages, chip_rotation, gain_frac, re, im);
+            gain_re[n] = gain_t(re);
+            gain_im[n] = gain_t(im);
         }
     }
 };
 
 template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
-void generate_rom_header_cst(const char * filename) {
-    constexpr CRomGeneratorConst<In_W, NStages, Tq> rom {};
-
-    FILE * rom_file = fopen(filename, "w");
-    if (!bool(rom_file)) {
-        perror("Can't open the rom file for writing.");
-        exit(EXIT_FAILURE);
-    }
-
-    char upper_file_def[64];
-    snprintf(upper_file_def, 64, "CORDIC_ROMS_CST_%u_%u_%u_%u", In_W, NStages, Tq, divider);
+void generate_rom_header_cst(const char * filename, bool with_gain = false) {
+    constexpr CRomGeneratorConst<In_W, NStages, Tq, divider> rom {};
 
     char rom_name[64];
     snprintf(rom_name, 64, "cst_%u_%u_%u_%u", In_W, NStages, Tq, divider);
 
-    fprintf(rom_file, "/** @file %s\n * THIS FILE IS GENERATED AUTOMATICALY, DO NOT EDIT IT!\n */\n", filename);
-
-    fprintf(rom_file, "#ifndef %s\n#define %s\n\n", upper_file_def, upper_file_def);
-    fprintf(rom_file, "#include <cstdint>\n\n");
-    fprintf(rom_file, "namespace cordic_roms {\n\n");
+    if (with_gain) {
+        constexpr CRomGainConst<In_W, NStages, Tq, divider> gain {};
+        rcr::generate_rom_header(filename, rom_name, rom.rom, rom.max_length, gain.gain_frac, gain.gain_re, gain.gain_im);
+    } else {
+        rcr::generate_rom_header(filename, rom_name, rom.rom, rom.max_length);
+    }
+}
 
-    fprintf(rom_file, "constexpr uint64_t %s_size = %d;\n\n", rom_name, rom.max_length);
+template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
+void generate_kernel_header_cst(const char * filename) {
+    constexpr CRomGeneratorConst<In_W, NStages, Tq, divider> rom {};
 
-    fprintf(rom_file, "constexpr uint8_t %s[%d] = {\n  ", rom_name, rom.max_length);
-    for (uint16_t u = 0; u < rom.max_length - 1; u++) {
-        if (((u & 7) == 0) && u != 0) {
-            fprintf(rom_file, "\n  ");
-        }
-        fprintf(rom_file, "%3d, ", uint16_t(rom.rom[u]));
-    }
-    fprintf(rom_file, "%3d};\n", uint16_t(rom.rom[rom.max_length - 1]));
+    char rom_name[64];
+    snprintf(rom_name, 64, "cst_%u_%u_%u_%u", In_W, NStages, Tq, divider);
 
-    fprintf(rom_file, "\n} // namespace cordic_roms\n\n");
-    fprintf(rom_file, "#endif // %s\n\n", upper_file_def);
+    rcr::generate_rom_kernels(filename, rom_name, rom.rom, rom.max_length, In_W, NStages);
 }
 
 template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
 void generate_rom_header_cst_raw(const char * filename = "rom_cordic.txt") {
     constexpr CRomGeneratorConst<In_W, NStages, Tq, divider> rom {};
 
-    FILE * rom_file = fopen(filename, "w");
-    if (!bool(rom_file)) {
-        perror("Can't open the rom file for writing.");
-        exit(EXIT_FAILURE);
-    }
-
-    for (uint16_t u = 0; u < rom.max_length - 1; u++) {
-        fprintf(rom_file, "%03d\n", uint16_t(rom.rom[u]));
-    }
-    fprintf(rom_file, "%03d\n\n", uint16_t(rom.rom[rom.max_length - 1]));
+    rcr::generate_rom_raw(filename, rom.rom, rom.max_length);
 }
 
 #endif // STANDARD GUARD
@@ -20,14 +20,15 @@
 #ifndef _ROM_GENERATOR_ML
 #define _ROM_GENERATOR_ML
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
 #include <complex>
 #include <cstdint>
+#include <vector>
 
 #include "RomRotateCommon/definitions.hpp"
-
-namespace rcr = rom_cordic_rotate;
+#include "RomRotateCommon/emitters.hpp"
 
 #if __cplusplus >= 201402L || XILINX_MAJOR > 2019
 #define OWN_CONSTEXPR constexpr
@@ -35,152 +36,192 @@ namespace rcr = rom_cordic_rotate;
 #define OWN_CONSTEXPR
 #endif
 
+namespace rom_cordic_rotate {
+
+OWN_CONSTEXPR inline std::complex<int64_t> cordic_ml(const std::complex<int64_t> & x_in,
+                                                     uint8_t                       counter,
+                                                     unsigned                      nb_stages) {
+
+    int64_t A = x_in.real();
+    int64_t B = x_in.imag();
+
+    const uint8_t R    = counter;
+    uint8_t       mask = 0x01;
+    if ((R & mask) == mask) {
+        A = -A;
+        B = -B;
+    }
+
+    for (uint16_t u = 1; u < nb_stages + 1; u++) {
+        mask = mask << 1;
+
+        const int64_t Ri = (R & mask) == mask ? 1 : -1;
+
+        const int64_t I = A + Ri * (B / int64_t(1U << (u - 1)));
+        B               = B - Ri * (A / int64_t(1U << (u - 1)));
+        A               = I;
+    }
+
+    return {A, B};
+}
+
+/**
+ * @brief Search, among the `search_length` first control words, the one whose
+ * `nb_stages` CORDIC best cancels a rotation of `-angle` on a `In_W` bits input.
+ *
+ * Only the `2^(nb_stages + 1)` distinct control words are tried, so long ROMs are generated
+ * in linear time.
+ */
+inline uint8_t ml_rom_entry(unsigned In_W, unsigned nb_stages, double angle, unsigned search_length) {
+    search_length = std::min(search_length, 1U << (nb_stages + 1));
+
+    const int64_t scale_factor = int64_t(1U << (In_W - 1));
+
+    const double re_x = floor(double(scale_factor - 1) * cos(-angle));
+    const double im_x = floor(double(scale_factor - 1) * sin(-angle));
+
+    const std::complex<int64_t> x {int64_t(re_x), int64_t(im_x)};
+
+    double  error = 1000.;
+    uint8_t rom_v = 0x0;
+
+    for (uint32_t v = 0; v < search_length; v++) {
+        const std::complex<int64_t> res_int = cordic_ml(x, uint8_t(v), nb_stages);
+
+        const std::complex<double> res_dbl(double(res_int.real()) / double(scale_factor - 1),
+                                           double(res_int.imag()) / double(scale_factor - 1));
+
+        const double curr_error = std::abs(std::arg(res_dbl));
+        if (curr_error < error) {
+            error = curr_error;
+            rom_v = uint8_t(v);
+        }
+    }
+
+    return rom_v;
+}
+
+/**
+ * @brief Measure the gain correction of the control word `R` chosen for `angle`.
+ *
+ * The very test vector of `ml_rom_entry` is rotated, and the correction is the inverse of
+ * the complex gain actually obtained (magnitude and residual angle), on `gain_frac` fractional bits.
+ */
+inline void ml_rom_gain(unsigned In_W, unsigned nb_stages, double angle, uint8_t R, unsigned gain_frac,
+                        int64_t & gain_re, int64_t & gain_im) {
+    const int64_t scale_factor = int64_t(1U << (In_W - 1));
+
+    const double re_x = floor(double(scale_factor - 1) * cos(-angle));
+    const double im_x = floor(double(scale_factor - 1) * sin(-angle));
+
+    const std::complex<int64_t> x {int64_t(re_x), int64_t(im_x)};
+    const std::complex<int64_t> res_int = cordic_ml(x, R, nb_stages);
+
+    // Expected: x * exp(j * angle), which is real by construction.
+    const std::complex<double> expected = std::complex<double>(re_x, im_x) * std::polar(1., angle);
+    const std::complex<double> obtained(double(res_int.real()), double(res_int.imag()));
+
+    const std::complex<double> correction = expected / obtained * double(int64_t(1) << gain_frac);
+
+    gain_re = int64_t(std::llround(correction.real()));
+    gain_im = int64_t(std::llround(correction.imag()));
+}
+
+} // namespace rom_cordic_rotate
+
+namespace rcr = rom_cordic_rotate;
+
 template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
 class CRomGeneratorML {
     static_assert(In_W > 0, "Inputs can't be on zero bits.");
     static_assert(NStages < 8, "7 stages of CORDIC is the maximum supported.");
     static_assert(NStages > 1, "2 stages of CORDIC is the minimum.");
-    static_assert(NStages > 1, "2 stages of CORDIC is the minimum.");
-    static_assert(rcr::is_pow_2<divider>(), "divider must be a power of 2.");
+    static_assert(Tq > 0, "q can't be zero.");
 
 public:
 #if __cplusplus >= 201402L || XILINX_MAJOR > 2019
-    static constexpr double rotation = rcr::pi / divider;
+    static constexpr double rotation = rcr::rom_rotation(divider);
     static constexpr double q        = Tq;
 
-    static constexpr unsigned max_length   = 2 * divider * Tq; // 2pi / (pi / divider) * q
+    static constexpr unsigned max_length   = unsigned(rcr::rom_length(Tq, divider));
     static constexpr unsigned addr_length  = rcr::needed_bits<max_length - 1>();
     static constexpr int64_t  scale_factor = int64_t(1U << (In_W - 1));
+    static constexpr unsigned gain_frac    = In_W + 1;
 #else
     const double   rotation;
     const double   q;
     const unsigned max_length;
     const unsigned addr_length;
     const int64_t  scale_factor;
+    const unsigned gain_frac;
 #endif
-private:
-    OWN_CONSTEXPR std::complex<int64_t> cordic_ML(const std::complex<int64_t> & x_in,
-                                                  uint8_t                       counter) {
-
-        int64_t A = x_in.real();
-        int64_t B = x_in.imag();
-
-        const uint8_t R    = counter;
-        uint8_t       mask = 0x01;
-        if ((R & mask) == mask) {
-            A = -A;
-            B = -B;
-        }
-
-        for (uint16_t u = 1; u < NStages + 1; u++) {
-            mask = mask << 1;
-
-            const int64_t Ri = (R & mask) == mask ? 1 : -1;
-
-            const int64_t I = A + Ri * (B / int64_t(1U << (u - 1)));
-            B               = B - Ri * (A / int64_t(1U << (u - 1)));
-            A               = I;
-        }
-
-        return {A, B};
-    }
-
 public:
 #if __cplusplus >= 201402L || XILINX_MAJOR > 2019
     uint8_t rom[max_length];
 #else
-    uint8_t        rom[2 * Tq * divider];
+    uint8_t        rom[rcr::rom_length(Tq, divider)];
 #endif
 
     CRomGeneratorML() 
 #if __cplusplus < 201402L
-        : rotation(rcr::pi / divider),
+        : rotation(rcr::rom_rotation(divider)),
           q(Tq),
-          max_length(2 * Tq * divider),
-          addr_length(rcr::needed_bits<2 * Tq * divider - 1>()),
-          scale_factor(int64_t(1U << (In_W - 1)))
+          max_length(unsigned(rcr::rom_length(Tq, divider))),
+          addr_length(rcr::needed_bits<uint32_t(rcr::rom_length(Tq, divider) - 1)>()),
+          scale_factor(int64_t(1U << (In_W - 1))),
+          gain_frac(In_W + 1)
 #endif
     {
         for (unsigned n = 0; n < max_length; n++) {
-            const double re_x = floor(double(scale_factor - 1) * cos(-rotation / double(q) * double(n)));
-            const double im_x = floor(double(scale_factor - 1) * sin(-rotation / double(q) * double(n)));
+            const double angle = rotation / double(q) * double(n);
 
-            const std::complex<int64_t> x {int64_t(re_x), int64_t(im_x)};
-
-            double  error = 1000.;
-            uint8_t rom_v = 0x0;
-
-            std::complex<double> res;
-            for (uint32_t v = 0; v < max_length; v++) {
-                const std::complex<int64_t> res_int = cordic_ML(x, v);
-
-                const std::complex<double> res_dbl(double(res_int.real()) / double(scale_factor - 1),
-                                                   double(res_int.imag()) / double(scale_factor - 1));
+            rom[n] = rcr::ml_rom_entry(In_W, NStages, angle, max_length);
+        }
+    }
 
-                const double curr_error = std::abs(std::arg(res_dbl));
-                if (curr_error < error) {
-                    error = curr_error;
-                    rom_v = uint8_t(v);
-                    res   = res_dbl;
-                }
-            }
+    /// Per-address gain correction, measured on the test vector of each control word.
+    void gains(std::vector<int64_t> & gain_re, std::vector<int64_t> & gain_im) const {
+        gain_re.resize(max_length);
+        gain_im.resize(max_length);
 
-            rom[n] = rom_v;
+        for (unsigned n = 0; n < max_length; n++) {
+            const double angle = rotation / double(q) * double(n);
+            rcr::ml_rom_gain(In_W, NStages, angle, rom[n], gain_frac, gain_re[n], gain_im[n]);
         }
     }
 };
 
 template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
-void generate_rom_header_ml(const char * filename) {
+void generate_rom_header_ml(const char * filename, bool with_gain = false) {
     const CRomGeneratorML<In_W, NStages, Tq, divider> rom;
 
-    FILE * rom_file = fopen(filename, "w");
-    if (!bool(rom_file)) {
-        perror("Can't open the rom file for writing.");
-        exit(EXIT_FAILURE);
-    }
-
-    char upper_file_def[64];
-    snprintf(upper_file_def, 64, "CORDIC_ROMS_ML_%u_%u_%u_%u", In_W, NStages, Tq, divider);
-
     char rom_name[64];
     snprintf(rom_name, 64, "ml_%u_%u_%u_%u", In_W, NStages, Tq, divider);
 
-    fprintf(rom_file, "/** @file %s\n * THIS FILE IS GENERATED AUTOMATICALY, DO NOT EDIT IT!\n */\n", filename);
-
-    fprintf(rom_file, "#ifndef %s\n#define %s\n\n", upper_file_def, upper_file_def);
-    fprintf(rom_file, "#include <cstdint>\n\n");
-    fprintf(rom_file, "namespace cordic_roms {\n\n");
+    if (with_gain) {
+        std::vector<int64_t> gain_re, gain_im;
+        rom.gains(gain_re, gain_im);
+        rcr::generate_rom_header(filename, rom_name, rom.rom, rom.max_length, rom.gain_frac, gain_re.data(), gain_im.data());
+    } else {
+        rcr::generate_rom_header(filename, rom_name, rom.rom, rom.max_length);
+    }
+}
 
-    fprintf(rom_file, "constexpr uint64_t %s_size = %d;\n\n", rom_name, rom.max_length);
+template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
+void generate_kernel_header_ml(const char * filename) {
+    const CRomGeneratorML<In_W, NStages, Tq, divider> rom;
 
-    fprintf(rom_file, "constexpr uint8_t  %s[%d] = {\n  ", rom_name, rom.max_length);
-    for (uint16_t u = 0; u < rom.max_length - 1; u++) {
-        if (((u & 7) == 0) && u != 0) {
-            fprintf(rom_file, "\n  ");
-        }
-        fprintf(rom_file, "%3d, ", uint16_t(rom.rom[u]));
-    }
-    fprintf(rom_file, "%3d};\n", uint16_t(rom.rom[rom.max_length - 1]));
+    char rom_name[64];
+    snprintf(rom_name, 64, "ml_%u_%u_%u_%u", In_W, NStages, Tq, divider);
 
-    fprintf(rom_file, "\n} // namespace cordic_roms\n\n");
-    fprintf(rom_file, "#endif // %s\n\n", upper_file_def);
+    rcr::generate_rom_kernels(filename, rom_name, rom.rom, rom.max_length, In_W, NStages);
 }
 
 template <unsigned In_W, unsigned NStages, unsigned Tq, unsigned divider = 2>
 void generate_rom_header_ml_raw(const char * filename) {
     const CRomGeneratorML<In_W, NStages, Tq, divider> rom;
 
-    FILE * rom_file = fopen(filename, "w");
-    if (!bool(rom_file)) {
-        perror("Can't open the rom file for writing.");
-        exit(EXIT_FAILURE);
-    }
-
-    for (uint16_t u = 0; u < rom.max_length - 1; u++) {
-        fprintf(rom_file, "%03d\n", uint16_t(rom.rom[u]));
-    }
-    fprintf(rom_file, "%03d\n\n", uint16_t(rom.rom[rom.max_length - 1]));
+    rcr::generate_rom_raw(filename, rom.rom, rom.max_length);
 }
 
 #undef OWN_CONSTEXPR
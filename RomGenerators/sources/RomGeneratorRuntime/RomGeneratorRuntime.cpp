@@ -0,0 +1,72 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RomGeneratorRuntime.hpp"
+
+#include "RomGeneratorConst/RomGeneratorConst.hpp"
+#include "RomGeneratorML/RomGeneratorML.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+bool CRomGeneratorRuntime::valid_parameters(unsigned In_W, unsigned nb_stages, unsigned q, unsigned divider) {
+    return In_W > 0 && In_W <= 32
+        && nb_stages > 1 && nb_stages < 8
+        && q > 0
+        && rcr::rom_length(q, divider) <= UINT32_MAX;
+}
+
+CRomGeneratorRuntime::CRomGeneratorRuntime(rcr::generator_type type, unsigned In_W, unsigned nb_stages, unsigned q, unsigned divider)
+    : type(type),
+      In_W(In_W),
+      nb_stages(nb_stages),
+      q(q),
+      divider(divider),
+      rotation(rcr::rom_rotation(divider)),
+      max_length(unsigned(rcr::rom_length(q, divider))),
+      addr_length(rcr::needed_bits(max_length - 1)),
+      gain_frac(In_W + 1),
+      rom(max_length) {
+
+    if (!valid_parameters(In_W, nb_stages, q, divider)) {
+        fprintf(stderr, "Invalid ROM parameters: W=%u, stages=%u, q=%u, divider=%u.\n", In_W, nb_stages, q, divider);
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned n = 0; n < max_length; n++) {
+        const double chip_rotation = rotation / double(q) * double(n);
+        rom[n]                     = type == rcr::generator_type::cst
+                                       ? rcr::cst_rom_entry(nb_stages, chip_rotation)
+                                       : rcr::ml_rom_entry(In_W, nb_stages, chip_rotation, max_length);
+    }
+}
+
+void CRomGeneratorRuntime::gains(std::vector<int64_t> & gain_re, std::vector<int64_t> & gain_im) const {
+    gain_re.resize(max_length);
+    gain_im.resize(max_length);
+
+    for (unsigned n = 0; n < max_length; n++) {
+        const double chip_rotation = rotation / double(q) * double(n);
+        if (type == rcr::generator_type::cst) {
+            rcr::cst_rom_gain(nb_stages, chip_rotation, gain_frac, gain_re[n], gain_im[n]);
+        } else {
+            rcr::ml_rom_gain(In_W, nb_stages, chip_rotation, rom[n], gain_frac, gain_re[n], gain_im[n]);
+        }
+    }
+}
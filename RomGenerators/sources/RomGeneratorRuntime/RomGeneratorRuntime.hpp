@@ -0,0 +1,62 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ROM_GENERATOR_RUNTIME_
+#define _ROM_GENERATOR_RUNTIME_
+
+#if __cplusplus >= 201402L || XILINX_MAJOR > 2019
+
+#include <cstdint>
+#include <vector>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief Runtime counterpart of CRomGeneratorConst and CRomGeneratorML.
+ *
+ * Produces the same tables as the template generators, but from parameters known
+ * only at runtime, so that many configurations can be built in a single process.
+ */
+class CRomGeneratorRuntime {
+public:
+    const rcr::generator_type type;
+    const unsigned            In_W;
+    const unsigned            nb_stages;
+    const unsigned            q;
+    const unsigned            divider;
+
+    const double   rotation;
+    const unsigned max_length;
+    const unsigned addr_length;
+    const unsigned gain_frac;
+
+    std::vector<uint8_t> rom;
+
+    CRomGeneratorRuntime(rcr::generator_type type, unsigned In_W, unsigned nb_stages, unsigned q, unsigned divider = 2);
+
+    /// Per-address gain correction, the same as `CRomGainConst` or `CRomGeneratorML::gains()`.
+    void gains(std::vector<int64_t> & gain_re, std::vector<int64_t> & gain_im) const;
+
+    static bool valid_parameters(unsigned In_W, unsigned nb_stages, unsigned q, unsigned divider);
+};
+
+#endif // STANDARD GUARD
+#endif // _ROM_GENERATOR_RUNTIME_
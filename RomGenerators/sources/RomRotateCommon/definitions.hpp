@@ -22,6 +22,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <type_traits>
 
 namespace rom_cordic_rotate {
 
@@ -36,6 +37,27 @@ constexpr double inv_pi  = 1 / pi;
 constexpr double two_pi  = 2 * pi;
 constexpr double inv_2pi = 0.5 * inv_pi;
 
+// ``` GNU Octave
+// kn_values(X) = prod(1 ./ abs(1 + 1j * 2.^ (-(0:X))))
+// ```
+constexpr double kn_values[7] = {
+    0.70710678118655, 0.632455532033680, 0.613571991077900,
+    0.608833912517750, 0.607648256256170, 0.607351770141300, 0.607277644093530};
+
+constexpr double atan_values[28] = {
+    0.78539816339745, 0.46364760900081, 0.24497866312686, 0.12435499454676,
+    0.06241880999596, 0.03123983343027, 0.01562372862048, 0.00781234106010,
+    0.00390623013197, 0.00195312251648, 0.00097656218956, 0.00048828121119,
+    0.00024414062015, 0.00012207031189, 0.00006103515617, 0.00003051757812,
+    0.00001525878906, 0.00000762939453, 0.00000381469727, 0.00000190734863,
+    0.00000095367432, 0.00000047683716, 0.00000023841858, 0.00000011920929,
+    0.00000005960464, 0.00000002980232, 0.00000001490116, 0.00000000745058};
+
+enum class generator_type : uint8_t {
+    ml  = 0,
+    cst = 1
+};
+
 #if __cplusplus >= 201402L || XILINX_MAJOR > 2019  
 
 constexpr uint32_t needed_bits(uint32_t value) {
@@ -51,6 +73,15 @@ constexpr bool is_pow_2(uint32_t value) {
     return (1U << (needed_bits(value) - 1)) == value;
 }
 
+/// Angle actually rotated by a `nb_stages` CORDIC driven by the control word `R`.
+constexpr double rom_angle(uint8_t R, unsigned nb_stages) {
+    double angle = (R & 0x01) ? pi : 0.;
+    for (unsigned u = 1; u < nb_stages + 1; u++) {
+        angle += ((R >> u) & 0x01) ? -atan_values[u - 1] : atan_values[u - 1];
+    }
+    return angle;
+}
+
 #endif
 
 template <uint32_t value>
@@ -75,6 +106,66 @@ constexpr bool is_pow_2<0>() {
     return false;
 }
 
+/// Signed bits of a gain correction on `gain_frac` fractional bits, whose magnitude stays below 2.
+constexpr unsigned gain_bits(unsigned gain_frac) {
+    return gain_frac + 2;
+}
+
+/// Narrowest standard signed integer holding `bits` bits, used to store the gain corrections.
+template <unsigned bits>
+struct least_int {
+    typedef typename std::conditional<bits <= 8, int8_t,
+                                      typename std::conditional<bits <= 16, int16_t,
+                                                                typename std::conditional<bits <= 32, int32_t, int64_t>::type>::type>::type type;
+};
+
+/// Name of `least_int<bits>::type`, for the generated headers.
+constexpr const char * least_int_name(unsigned bits) {
+    return bits <= 8 ? "int8_t" : bits <= 16 ? "int16_t" : bits <= 32 ? "int32_t" : "int64_t";
+}
+
+constexpr uint32_t gcd(uint32_t a, uint32_t b) {
+    return b == 0 ? a : gcd(b, a % b);
+}
+
+/**
+ * @brief Words of a `(q, divider)` ROM, which is exactly one period of its counter.
+ *
+ * Addresses step by `pi / (divider * q)`, so the ROM holds `2 * divider * q` words.
+ * `divider == 0` stands for `q` addresses spanning a full turn: the ROM holds `q` words,
+ * odd `q` included.
+ */
+constexpr uint64_t rom_length(uint64_t q, uint64_t divider) {
+    return divider == 0 ? q : 2 * divider * q;
+}
+
+/// Angle of `q` consecutive addresses: `pi / divider`, or a full turn for `divider == 0`.
+constexpr double rom_rotation(unsigned divider) {
+    return divider == 0 ? two_pi : pi / divider;
+}
+
+/**
+ * @brief ROM parameters of a rotation step of `2 * pi * num / den`.
+ *
+ * The ROM is addressed modulo the `period` of the step, which need not be even nor a power
+ * of two: `q = period` and `divider = 0`, so `max_length == period`. The numerator becomes
+ * the `stride` added to the counter at each sample, modulo `period`.
+ * ``` C++
+ * typedef rcr::rational_step<1, 3001> step;
+ * typedef CCordicRotateConstexpr<16, 4, 6, step::q, step::divider> cordic; // max_length == 3001
+ * ```
+ */
+template <uint32_t num, uint32_t den>
+struct rational_step {
+    static_assert(den > 0, "The step denominator can't be zero.");
+    static_assert(num % den != 0, "The step must not be a multiple of 2 * pi.");
+
+    static constexpr uint32_t period  = den / gcd(num % den, den);
+    static constexpr uint32_t stride  = (num % den) / gcd(num % den, den);
+    static constexpr uint32_t q       = period;
+    static constexpr uint32_t divider = 0;
+};
+
 } // namespace rom_cordic_rotate
 
 #endif // _ROMCORDIC_DEFINITIONS_HPP_
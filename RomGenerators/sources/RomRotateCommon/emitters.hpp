@@ -0,0 +1,220 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ROMCORDIC_EMITTERS_HPP_
+#define _ROMCORDIC_EMITTERS_HPP_
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rom_cordic_rotate {
+
+/**
+ * @brief Emit the `part` ("re" or "im") of a per-address gain correction as a `constexpr` array.
+ *
+ * The words are stored in the narrowest integer holding `gain_bits(gain_frac)` signed bits.
+ */
+template <typename gain_t>
+void generate_rom_gain_array(FILE * rom_file, const char * rom_name, const char * part,
+                             unsigned gain_frac, const gain_t * values, unsigned length) {
+    if (values == nullptr || length == 0) {
+        return;
+    }
+
+    const unsigned bits  = gain_bits(gain_frac);
+    const int64_t  limit = int64_t(1) << (bits - 1);
+    for (unsigned u = 0; u < length; u++) {
+        if (int64_t(values[u]) < -limit || int64_t(values[u]) >= limit) {
+            fprintf(stderr, "Gain correction %" PRId64 " of %s does not fit on %u bits.\n", int64_t(values[u]), rom_name, bits);
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    fprintf(rom_file, "constexpr %s %s_gain_%s[%u] = {\n  ", least_int_name(bits), rom_name, part, length);
+    for (unsigned u = 0; u < length - 1; u++) {
+        if (((u & 7) == 0) && u != 0) {
+            fprintf(rom_file, "\n  ");
+        }
+        fprintf(rom_file, "%11" PRId64 ", ", int64_t(values[u]));
+    }
+    fprintf(rom_file, "%11" PRId64 "};\n", int64_t(values[length - 1]));
+}
+
+/// Upper-cased `<prefix><rom_name>`, used as include guard.
+inline void generate_guard_name(char * guard, size_t size, const char * prefix, const char * rom_name) {
+    snprintf(guard, size, "%s%s", prefix, rom_name);
+    for (char * c = guard; *c != '\0'; c++) {
+        *c = (*c >= 'a' && *c <= 'z') ? char(*c - 'a' + 'A') : *c;
+    }
+}
+
+/// File name without its directories, for the `@file` tag of the generated headers.
+inline const char * generated_file_name(const char * filename) {
+    const char * slash = strrchr(filename, '/');
+    return slash != nullptr ? slash + 1 : filename;
+}
+
+/**
+ * @brief Emit the ROM header `rom_name` shared by every generator.
+ *
+ * When `gain_re` and `gain_im` are given, the per-address gain correction (on `gain_frac`
+ * fractional bits) is emitted along with the control words.
+ */
+template <typename gain_t = int64_t>
+void generate_rom_header(const char * filename, const char * rom_name, const uint8_t * rom, unsigned length,
+                         unsigned gain_frac = 0, const gain_t * gain_re = nullptr, const gain_t * gain_im = nullptr) {
+    FILE * rom_file = fopen(filename, "w");
+    if (!bool(rom_file)) {
+        perror("Can't open the rom file for writing.");
+        exit(EXIT_FAILURE);
+    }
+
+    char upper_file_def[80];
+    generate_guard_name(upper_file_def, 80, "CORDIC_ROMS_", rom_name);
+
+    fprintf(rom_file, "/** @file %s\n * THIS FILE IS GENERATED AUTOMATICALY, DO NOT EDIT IT!\n */\n", generated_file_name(filename));
+
+    fprintf(rom_file, "#ifndef %s\n#define %s\n\n", upper_file_def, upper_file_def);
+    fprintf(rom_file, "#include <cstdint>\n\n");
+    fprintf(rom_file, "namespace cordic_roms {\n\n");
+
+    fprintf(rom_file, "constexpr uint64_t %s_size = %u;\n\n", rom_name, length);
+
+    fprintf(rom_file, "constexpr uint8_t  %s[%u] = {\n  ", rom_name, length);
+    for (unsigned u = 0; u < length - 1; u++) {
+        if (((u & 7) == 0) && u != 0) {
+            fprintf(rom_file, "\n  ");
+        }
+        fprintf(rom_file, "%3d, ", uint16_t(rom[u]));
+    }
+    fprintf(rom_file, "%3d};\n", uint16_t(rom[length - 1]));
+
+    if (gain_re != nullptr && gain_im != nullptr) {
+        fprintf(rom_file, "\nconstexpr unsigned %s_gain_frac = %u;\n", rom_name, gain_frac);
+        generate_rom_gain_array(rom_file, rom_name, "re", gain_frac, gain_re, length);
+        generate_rom_gain_array(rom_file, rom_name, "im", gain_frac, gain_im, length);
+    }
+
+    fprintf(rom_file, "\n} // namespace cordic_roms\n\n");
+    fprintf(rom_file, "#endif // %s\n\n", upper_file_def);
+
+    fclose(rom_file);
+}
+
+/// Emit the control words as text, one per line.
+inline void generate_rom_raw(const char * filename, const uint8_t * rom, unsigned length) {
+    FILE * rom_file = fopen(filename, "w");
+    if (!bool(rom_file)) {
+        perror("Can't open the rom file for writing.");
+        exit(EXIT_FAILURE);
+    }
+
+    for (unsigned u = 0; u < length - 1; u++) {
+        fprintf(rom_file, "%03d\n", uint16_t(rom[u]));
+    }
+    fprintf(rom_file, "%03d\n\n", uint16_t(rom[length - 1]));
+
+    fclose(rom_file);
+}
+
+/**
+ * @brief Emit a header in which each ROM address becomes a straight-line shift-add kernel.
+ *
+ * The pi-rotation and the direction of every stage are folded in as constants: a rotation
+ * needs neither ROM access nor per-stage branch, and HLS tools only see constant adders.
+ * Kernels are bit-exact with the `ap_int` datapath of the ROM-based rotators, and can be
+ * dispatched at compile time (`<name>_kernel<counter>(...)`) or through a dense switch
+ * (`<name>_kernel(..., counter, ...)`), usually compiled as a jump table. The switch zeroes
+ * the outputs of an address outside the ROM rather than leaving them unassigned.
+ */
+inline void generate_rom_kernels(const char * filename, const char * rom_name, const uint8_t * rom,
+                                 unsigned length, unsigned In_W, unsigned nb_stages) {
+    FILE * kernel_file = fopen(filename, "w");
+    if (!bool(kernel_file)) {
+        perror("Can't open the kernel file for writing.");
+        exit(EXIT_FAILURE);
+    }
+
+    const unsigned Out_W = In_W + 2;
+
+    char upper_file_def[80];
+    generate_guard_name(upper_file_def, 80, "CORDIC_KERNELS_", rom_name);
+
+    fprintf(kernel_file, "/** @file %s\n * THIS FILE IS GENERATED AUTOMATICALY, DO NOT EDIT IT!\n */\n", generated_file_name(filename));
+
+    fprintf(kernel_file, "#ifndef %s\n#define %s\n\n", upper_file_def, upper_file_def);
+    fprintf(kernel_file, "#include <ap_int.h>\n\n");
+    fprintf(kernel_file, "namespace cordic_roms {\n\n");
+
+    fprintf(kernel_file, "template <unsigned counter>\n");
+    fprintf(kernel_file, "void %s_kernel(const ap_int<%u> & re_in, const ap_int<%u> & im_in, ap_int<%u> & re_out, ap_int<%u> & im_out);\n",
+            rom_name, In_W, In_W, Out_W, Out_W);
+
+    for (unsigned n = 0; n < length; n++) {
+        const uint8_t R = rom[n];
+
+        fprintf(kernel_file, "\ntemplate <>\n");
+        fprintf(kernel_file, "inline void %s_kernel<%u>(const ap_int<%u> & re_in, const ap_int<%u> & im_in, ap_int<%u> & re_out, ap_int<%u> & im_out) {\n",
+                rom_name, n, In_W, In_W, Out_W, Out_W);
+        if ((R & 0x01) != 0) {
+            fprintf(kernel_file, "    ap_int<%u> A = ap_int<%u>(-re_in);\n", Out_W, In_W);
+            fprintf(kernel_file, "    ap_int<%u> B = ap_int<%u>(-im_in);\n", Out_W, In_W);
+        } else {
+            fprintf(kernel_file, "    ap_int<%u> A = re_in;\n", Out_W);
+            fprintf(kernel_file, "    ap_int<%u> B = im_in;\n", Out_W);
+        }
+        fprintf(kernel_file, "    ap_int<%u> I;\n", Out_W);
+
+        for (unsigned u = 1; u < nb_stages + 1; u++) {
+            const bool negative = ((R >> u) & 0x01) != 0;
+            if (u == 1) {
+                fprintf(kernel_file, "    I = A %c B;\n    B = B %c A;\n    A = I;\n",
+                        negative ? '+' : '-', negative ? '-' : '+');
+            } else {
+                fprintf(kernel_file, "    {\n        const ap_int<%u> shifted_A = A >> %u;\n        const ap_int<%u> shifted_B = B >> %u;\n",
+                        Out_W, u - 1, Out_W, u - 1);
+                fprintf(kernel_file, "        I = A %c shifted_B;\n        B = B %c shifted_A;\n        A = I;\n    }\n",
+                        negative ? '+' : '-', negative ? '-' : '+');
+            }
+        }
+        fprintf(kernel_file, "    re_out = A;\n    im_out = B;\n}\n");
+    }
+
+    fprintf(kernel_file, "\ninline void %s_kernel(const ap_int<%u> & re_in, const ap_int<%u> & im_in, unsigned counter, ap_int<%u> & re_out, ap_int<%u> & im_out) {\n",
+            rom_name, In_W, In_W, Out_W, Out_W);
+    fprintf(kernel_file, "    switch (counter) {\n");
+    for (unsigned n = 0; n < length; n++) {
+        fprintf(kernel_file, "    case %u:\n        %s_kernel<%u>(re_in, im_in, re_out, im_out);\n        break;\n", n, rom_name, n);
+    }
+    fprintf(kernel_file, "    default:\n        re_out = 0;\n        im_out = 0;\n        break;\n    }\n}\n");
+
+    fprintf(kernel_file, "\n} // namespace cordic_roms\n\n");
+    fprintf(kernel_file, "#endif // %s\n\n", upper_file_def);
+
+    fclose(kernel_file);
+}
+
+} // namespace rom_cordic_rotate
+
+#endif // _ROMCORDIC_EMITTERS_HPP_
@@ -0,0 +1,57 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ROMCORDIC_LCG_HPP_
+#define _ROMCORDIC_LCG_HPP_
+
+#include <cstdint>
+
+namespace rom_cordic_rotate {
+
+/**
+ * @brief 64-bit linear congruential generator (Knuth's MMIX constants).
+ *
+ * Reproducible test vectors for the tools and testbenches; the upper bits are used,
+ * the low ones of an LCG having short periods.
+ */
+class lcg {
+    uint64_t state;
+
+public:
+    explicit lcg(uint64_t seed = 0x2545F4914F6CDD1DULL) : state(seed) {}
+
+    uint64_t next() {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        return state;
+    }
+
+    /// Integer in [`low`, `high`].
+    int64_t uniform(int64_t low, int64_t high) {
+        return int64_t((next() >> 11) % uint64_t(high - low + 1)) + low;
+    }
+
+    /// Double in [0, 1[, on 53 bits.
+    double unit() {
+        return double(next() >> 11) / double(1ULL << 53);
+    }
+};
+
+} // namespace rom_cordic_rotate
+
+#endif // _ROMCORDIC_LCG_HPP_
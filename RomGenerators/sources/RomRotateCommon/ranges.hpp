@@ -0,0 +1,84 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef _ROMCORDIC_RANGES_HPP_
+#define _ROMCORDIC_RANGES_HPP_
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rom_cordic_rotate {
+
+inline const char * type_name(generator_type type) {
+    return type == generator_type::ml ? "ml" : "cst";
+}
+
+/// Accepts `a:b` (every value, or every power of two when `doubling`), or a list `a,b,c`.
+inline std::vector<unsigned> parse_range(const char * arg, bool doubling) {
+    std::vector<unsigned> values;
+
+    const char * colon = strchr(arg, ':');
+    if (colon != nullptr) {
+        const unsigned first = unsigned(strtoul(arg, nullptr, 10));
+        const unsigned last  = unsigned(strtoul(colon + 1, nullptr, 10));
+        for (unsigned v = first; v <= last && v > 0; v = doubling ? 2 * v : v + 1) {
+            values.push_back(v);
+        }
+    } else {
+        std::string list(arg);
+        size_t      start = 0;
+        while (start <= list.size()) {
+            const size_t end = std::min(list.find(',', start), list.size());
+            values.push_back(unsigned(std::stoul(list.substr(start, end - start))));
+            start = end + 1;
+        }
+    }
+
+    if (values.empty()) {
+        fprintf(stderr, "Empty range: %s\n", arg);
+        exit(EXIT_FAILURE);
+    }
+    return values;
+}
+
+/// Accepts 'cst', 'ml' or 'cst,ml'.
+inline std::vector<generator_type> parse_types(const char * arg) {
+    std::vector<generator_type> types;
+    if (strstr(arg, "cst") != nullptr) {
+        types.push_back(generator_type::cst);
+    }
+    if (strstr(arg, "ml") != nullptr) {
+        types.push_back(generator_type::ml);
+    }
+    if (types.empty()) {
+        fprintf(stderr, "Unknown ROM type list: %s (expected 'cst', 'ml' or 'cst,ml')\n", arg);
+        exit(EXIT_FAILURE);
+    }
+    return types;
+}
+
+} // namespace rom_cordic_rotate
+
+#endif // _ROMCORDIC_RANGES_HPP_
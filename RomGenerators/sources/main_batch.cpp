@@ -0,0 +1,228 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file main_batch.cpp
+ * Generate many CORDIC ROMs in a single invocation.
+ *
+ * Every (type, W, stages, q, divider) combination of the requested ranges is generated in
+ * parallel, and written as a ROM header (the very same as `rom_generator`), and optionally as
+ * straight-line kernels, raw control words and verification results.
+ */
+
+#include "RomGeneratorML/RomGeneratorML.hpp"
+#include "RomGeneratorRuntime/RomGeneratorRuntime.hpp"
+#include "RomRotateCommon/emitters.hpp"
+#include "RomRotateCommon/ranges.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct batch_job {
+    rcr::generator_type type;
+    unsigned            W;
+    unsigned            stages;
+    unsigned            q;
+    unsigned            divider;
+
+    double max_error;
+};
+
+struct batch_outputs {
+    string directory;
+    bool   gain;
+    bool   kernels;
+    bool   raw;
+    bool   check;
+};
+
+// Rotate the largest real input by every address, and write the gain-compensated outputs.
+static double check_rom(const CRomGeneratorRuntime & rom, const char * filename) {
+    FILE * res_file = fopen(filename, "w");
+    if (!bool(res_file)) {
+        perror("Can't open the result file for writing.");
+        exit(EXIT_FAILURE);
+    }
+
+    const int64_t amplitude = (int64_t(1) << (rom.In_W - 1)) - 1;
+    const double  scale     = rcr::kn_values[rom.nb_stages - 1] / double(amplitude);
+
+    double max_error = 0.;
+    for (unsigned n = 0; n < rom.max_length; n++) {
+        const complex<int64_t> res = rcr::cordic_ml(complex<int64_t>(amplitude, 0), rom.rom[n], rom.nb_stages);
+        const complex<double>  obtained(double(res.real()) * scale, double(res.imag()) * scale);
+
+        max_error = max(max_error, abs(obtained - polar(1., rom.rotation / double(rom.q) * double(n))));
+        fprintf(res_file, "%.10f, %.10f\n", obtained.real(), obtained.imag());
+    }
+
+    fclose(res_file);
+    return max_error;
+}
+
+static void generate(batch_job & job, const batch_outputs & outputs) {
+    const CRomGeneratorRuntime rom(job.type, job.W, job.stages, job.q, job.divider);
+
+    char rom_name[64];
+    snprintf(rom_name, 64, "%s_%u_%u_%u_%u", rcr::type_name(job.type), job.W, job.stages, job.q, job.divider);
+
+    const string prefix = outputs.directory + "/";
+
+    if (outputs.gain) {
+        vector<int64_t> gain_re, gain_im;
+        rom.gains(gain_re, gain_im);
+        rcr::generate_rom_header((prefix + "cordic_rom_" + rom_name + ".hpp").c_str(), rom_name,
+                                 rom.rom.data(), rom.max_length, rom.gain_frac, gain_re.data(), gain_im.data());
+    } else {
+        rcr::generate_rom_header((prefix + "cordic_rom_" + rom_name + ".hpp").c_str(), rom_name,
+                                 rom.rom.data(), rom.max_length);
+    }
+
+    if (outputs.kernels) {
+        rcr::generate_rom_kernels((prefix + "cordic_kernels_" + rom_name + ".hpp").c_str(), rom_name,
+                                  rom.rom.data(), rom.max_length, rom.In_W, rom.nb_stages);
+    }
+    if (outputs.raw) {
+        rcr::generate_rom_raw((prefix + "rom_cordic_" + rom_name + ".txt").c_str(), rom.rom.data(), rom.max_length);
+    }
+    job.max_error = outputs.check ? check_rom(rom, (prefix + "result_" + rom_name + ".dat").c_str()) : NAN;
+}
+
+static void usage(const char * name) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --type    LIST   ROM generators among 'cst' and 'ml'        (default: ml)\n"
+            "  --w       RANGE  input bit widths                           (default: 16)\n"
+            "  --stages  RANGE  CORDIC stages, within [2; 7]               (default: 2:7)\n"
+            "  --q       RANGE  rotation divisions, a:b doubles            (default: 64)\n"
+            "  --divider RANGE  rotation denominators, a:b doubles         (default: 2)\n"
+            "  --output  DIR    existing output directory                  (default: .)\n"
+            "  --threads N      worker threads                             (default: all cores)\n"
+            "  --gain           emit the per-address gain correction in the headers\n"
+            "  --kernels        also emit the straight-line kernel headers\n"
+            "  --raw            also dump the control words as text\n"
+            "  --check          also write the rotation of a reference input by every address\n"
+            "RANGE is either 'a:b' or a comma separated list 'a,b,c'.\n",
+            name);
+}
+
+int main(int argc, char * argv[]) {
+    vector<rcr::generator_type> types    = {rcr::generator_type::ml};
+    vector<unsigned>            widths   = rcr::parse_range("16", false);
+    vector<unsigned>            stages   = rcr::parse_range("2:7", false);
+    vector<unsigned>            qs       = rcr::parse_range("64", true);
+    vector<unsigned>            dividers = rcr::parse_range("2", true);
+
+    batch_outputs outputs {".", false, false, false, false};
+    unsigned      threads = max(1U, thread::hardware_concurrency());
+
+    for (int i = 1; i < argc; i++) {
+        const string opt(argv[i]);
+        if (opt == "--gain") {
+            outputs.gain = true;
+            continue;
+        }
+        if (opt == "--kernels") {
+            outputs.kernels = true;
+            continue;
+        }
+        if (opt == "--raw") {
+            outputs.raw = true;
+            continue;
+        }
+        if (opt == "--check") {
+            outputs.check = true;
+            continue;
+        }
+        if (opt == "--help" || i + 1 >= argc) {
+            usage(argv[0]);
+            return opt == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        const char * value = argv[++i];
+        if (opt == "--type") {
+            types = rcr::parse_types(value);
+        } else if (opt == "--w") {
+            widths = rcr::parse_range(value, false);
+        } else if (opt == "--stages") {
+            stages = rcr::parse_range(value, false);
+        } else if (opt == "--q") {
+            qs = rcr::parse_range(value, true);
+        } else if (opt == "--divider") {
+            dividers = rcr::parse_range(value, true);
+        } else if (opt == "--output") {
+            outputs.directory = value;
+        } else if (opt == "--threads") {
+            threads = max(1U, unsigned(stoul(value)));
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    vector<batch_job> jobs;
+    for (rcr::generator_type t : types) {
+        for (unsigned w : widths) {
+            for (unsigned s : stages) {
+                for (unsigned q : qs) {
+                    for (unsigned d : dividers) {
+                        if (!CRomGeneratorRuntime::valid_parameters(w, s, q, d)) {
+                            fprintf(stderr, "Skipping invalid configuration %s W=%u stages=%u q=%u divider=%u\n",
+                                    rcr::type_name(t), w, s, q, d);
+                            continue;
+                        }
+                        jobs.push_back(batch_job {t, w, s, q, d, NAN});
+                    }
+                }
+            }
+        }
+    }
+
+    fprintf(stderr, "Generating %zu ROMs on %u threads...\n", jobs.size(), threads);
+
+    atomic<size_t> next {0};
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < jobs.size(); i = next++) {
+                generate(jobs[i], outputs);
+            }
+        });
+    }
+    for (thread & worker : workers) {
+        worker.join();
+    }
+
+    if (outputs.check) {
+        printf("%-4s %3s %6s %5s %7s | %10s\n", "type", "W", "stages", "q", "divider", "max_error");
+        for (const batch_job & j : jobs) {
+            printf("%-4s %3u %6u %5u %7u | %10.3e\n", rcr::type_name(j.type), j.W, j.stages, j.q, j.divider, j.max_error);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,61 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RomBundle/RomBundle.hpp"
+#include "RomGeneratorRuntime/RomGeneratorRuntime.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char * argv[]) {
+
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s <bundle file> <type:W:stages:q:divider>...\n"
+                        "  e.g. %s cordic_roms.bin ml:16:6:64:2 cst:12:4:128:4\n",
+                argv[0], argv[0]);
+        exit(EXIT_FAILURE);
+    }
+
+    vector<CRomGeneratorRuntime> roms;
+    roms.reserve(size_t(argc - 2));
+
+    for (int i = 2; i < argc; i++) {
+        char     type[4];
+        unsigned W, stages, q, divider;
+        if (sscanf(argv[i], "%3[a-z]:%u:%u:%u:%u", type, &W, &stages, &q, &divider) != 5
+            || (strcmp(type, "ml") != 0 && strcmp(type, "cst") != 0)
+            || !CRomGeneratorRuntime::valid_parameters(W, stages, q, divider)) {
+            fprintf(stderr, "Invalid ROM specification: %s\n", argv[i]);
+            exit(EXIT_FAILURE);
+        }
+
+        const rcr::generator_type gen_type = strcmp(type, "ml") == 0 ? rcr::generator_type::ml : rcr::generator_type::cst;
+        roms.emplace_back(gen_type, W, stages, q, divider);
+    }
+
+    if (!write_rom_bundle(argv[1], roms)) {
+        exit(EXIT_FAILURE);
+    }
+
+    return EXIT_SUCCESS;
+}
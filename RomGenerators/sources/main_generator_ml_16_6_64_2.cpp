@@ -0,0 +1,42 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "RomGeneratorConst/RomGeneratorConst.hpp"
+#include "RomGeneratorML/RomGeneratorML.hpp"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+int main(int, char **) {
+
+    const char filename[] = "cordic_rom_ml_16_6_64_2.hpp";
+
+    generate_rom_header_ml<16, 6, 64, 2>(filename, bool(0));
+
+#if 0
+    const char kernel_filename[] = "cordic_kernels_ml_16_6_64_2.hpp";
+
+    generate_kernel_header_ml<16, 6, 64, 2>(kernel_filename);
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,198 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_CARRIER_LOOP_HPP
+#define C_CORDIC_CARRIER_LOOP_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+#include <ap_int.h>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+enum class carrier_mode {
+    pll,         ///< Unmodulated carrier, the phase error is `arg(y)`.
+    costas_bpsk, ///< BPSK, the phase error is `arg(y)` modulo pi.
+    costas_qpsk  ///< QPSK, the phase error is `arg(y)` modulo pi / 2.
+};
+
+/**
+ * @brief Fixed-point carrier recovery: ROM-based derotation, CORDIC phase detector, PI loop filter.
+ *
+ * Phases and frequencies are on 32 bits, a full turn being `2^32`. Each sample is derotated by
+ * `Cordic` at the ROM address nearest to minus the NCO phase, then a vectoring CORDIC of
+ * `Tvec_stages` stages measures its phase, folded according to the modulation. The error drives
+ * a proportional-integral filter, whose output is the NCO frequency.
+ *
+ * Only the gains are computed in floating point, from the normalized loop bandwidth `Bn * T` and
+ * the damping factor; the per-sample loop is integer only. Derotated outputs are those of the
+ * `ap_int` `cordic` overload of `Cordic`, with its gain, on `Out_W` bits.
+ */
+template <class Cordic, unsigned Tvec_stages = 16>
+class CCordicCarrierLoop {
+    static_assert(Tvec_stages > 1 && Tvec_stages < 31, "Vectoring stages must be within [2; 30].");
+    static_assert(Cordic::Out_W + Tvec_stages + 2 < 63, "Vectoring must fit on 64 bits.");
+
+public:
+    static constexpr unsigned In_W       = Cordic::In_W;
+    static constexpr unsigned Out_W      = Cordic::Out_W;
+    static constexpr unsigned max_length = Cordic::max_length;
+    static constexpr unsigned vec_stages = Tvec_stages;
+    static constexpr unsigned gain_frac  = 24;
+
+    struct atan_table {
+        int64_t values[vec_stages];
+
+        atan_table() {
+            for (unsigned i = 0; i < vec_stages; i++) {
+                values[i] = int64_t(std::llround(std::atan(std::ldexp(1., -int(i))) / rcr::two_pi * 4294967296.));
+            }
+        }
+    };
+
+    static const atan_table & atans() {
+        static const atan_table table;
+        return table;
+    }
+
+    /// Phase of `(re, im)`, a full turn being `2^32`, within `[-2^31; 2^31[`.
+    static int32_t vectoring(int64_t re, int64_t im) {
+        const atan_table & table = atans();
+
+        int64_t  x = re * (int64_t(1) << vec_stages);
+        int64_t  y = im * (int64_t(1) << vec_stages);
+        uint32_t z = 0;
+        if (x < 0) {
+            x = -x;
+            y = -y;
+            z = uint32_t(1) << 31;
+        }
+
+        for (unsigned i = 0; i < vec_stages; i++) {
+            const int64_t shifted_x = x >> i;
+            const int64_t shifted_y = y >> i;
+            if (y > 0) {
+                x += shifted_y;
+                y -= shifted_x;
+                z += uint32_t(table.values[i]);
+            } else {
+                x -= shifted_y;
+                y += shifted_x;
+                z -= uint32_t(table.values[i]);
+            }
+        }
+
+        return int32_t(z);
+    }
+
+private:
+    const carrier_mode mode;
+
+    int64_t kp; ///< On `gain_frac` fractional bits.
+    int64_t ki; ///< On `gain_frac` fractional bits.
+
+    uint32_t nco_phase;
+    int64_t  integrator; ///< NCO frequency, on `gain_frac` fractional bits.
+    int32_t  nco_frequency;
+    int32_t  last_error;
+
+public:
+    /**
+     * @param loop_bandwidth    Noise bandwidth `Bn * T`, normalized to the sample rate.
+     * @param damping           Damping factor of the second order loop.
+     * @param initial_frequency Initial NCO frequency, in turns per sample.
+     */
+    CCordicCarrierLoop(carrier_mode mode, double loop_bandwidth, double damping = 0.707, double initial_frequency = 0.)
+        : mode(mode) {
+        const double theta = loop_bandwidth / (damping + 0.25 / damping);
+        const double d     = 1. + 2. * damping * theta + theta * theta;
+        const double scale = double(int64_t(1) << gain_frac);
+
+        // The detector gain is 1: errors and phases share the same unit.
+        kp = int64_t(std::llround(4. * damping * theta / d * scale));
+        ki = int64_t(std::llround(4. * theta * theta / d * scale));
+
+        reset(initial_frequency);
+    }
+
+    void reset(double initial_frequency = 0.) {
+        nco_phase     = 0;
+        nco_frequency = int32_t(std::llround(initial_frequency * 4294967296.));
+        integrator    = int64_t(nco_frequency) * (int64_t(1) << gain_frac);
+        last_error    = 0;
+    }
+
+    /// ROM address derotating by the current NCO phase.
+    uint32_t counter() const {
+        const uint64_t minus_phase = uint32_t(0U - nco_phase);
+        const uint64_t address     = (minus_phase * max_length + (uint64_t(1) << 31)) >> 32;
+        return uint32_t(address == max_length ? 0 : address);
+    }
+
+    /// Derotate one `In_W`-bit sample, then update the loop.
+    void push(int64_t re_in, int64_t im_in, int64_t & re_out, int64_t & im_out) {
+        ap_int<Out_W> re, im;
+        Cordic::cordic(ap_int<In_W>(re_in), ap_int<In_W>(im_in), counter(), re, im);
+        re_out = re.to_int64();
+        im_out = im.to_int64();
+
+        // Folding the phase modulo 2pi / 2^fold, the error is multiplied then divided by 2^fold.
+        const unsigned fold  = mode == carrier_mode::pll ? 0 : (mode == carrier_mode::costas_bpsk ? 1 : 2);
+        const uint32_t phase = uint32_t(vectoring(re_out, im_out));
+        last_error           = int32_t(phase << fold) >> fold;
+
+        integrator += ki * last_error;
+        const int64_t frequency = (integrator + kp * last_error) >> gain_frac;
+
+        nco_frequency = int32_t(frequency);
+        nco_phase += uint32_t(nco_frequency);
+    }
+
+    void process(const int64_t * re_in, const int64_t * im_in, int64_t * re_out, int64_t * im_out, size_t nb_samples) {
+        for (size_t n = 0; n < nb_samples; n++) {
+            push(re_in[n], im_in[n], re_out[n], im_out[n]);
+        }
+    }
+
+    /// NCO phase, a full turn being `2^32`.
+    uint32_t phase() const {
+        return nco_phase;
+    }
+
+    /// NCO frequency, in `2^-32` turns per sample.
+    int32_t frequency() const {
+        return nco_frequency;
+    }
+
+    /// Last detected phase error, a full turn being `2^32`.
+    int32_t phase_error() const {
+        return last_error;
+    }
+
+    double frequency_turns() const {
+        return double(nco_frequency) / 4294967296.;
+    }
+};
+
+#endif // C_CORDIC_CARRIER_LOOP_HPP
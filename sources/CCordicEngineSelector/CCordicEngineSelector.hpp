@@ -0,0 +1,165 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ENGINE_SELECTOR_HPP
+#define C_CORDIC_ENGINE_SELECTOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "CCordicRotateLut/CCordicRotateLut.hpp"
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+#include "CCordicRotateSwar/CCordicRotateSwar.hpp"
+#include "CCordicRotateTwiddle/CCordicRotateTwiddle.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+/// Name used in the reports, specialize it for any new engine.
+template <class Engine>
+struct engine_name {
+    static const char * get() { return "cordic"; }
+};
+
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider>
+struct engine_name<CCordicRotateTwiddle<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider>> {
+    static const char * get() { return "twiddle"; }
+};
+
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider, bool Tcompressed>
+struct engine_name<CCordicRotateLut<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider, Tcompressed>> {
+    static const char * get() { return "lut"; }
+};
+
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider>
+struct engine_name<CCordicRotateSwar<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider>> {
+    static const char * get() { return "swar"; }
+};
+
+struct engine_report {
+    const char * name;
+    double       ns_per_sample;
+    double       max_error;
+    double       snr_db;
+};
+
+/**
+ * @brief Benchmark several engines of the same configuration and keep the fastest one.
+ *
+ * Every engine rotates the same pseudo-random block, at every address, through its `CCordicRotator`
+ * handle. Accuracy is measured on the gain-corrected outputs against a double-precision rotation.
+ * ``` C++
+ * auto selection = CCordicEngineSelector<CCordicRotateConstexpr<16, 4, 6, 64>,
+ *                                        CCordicRotateTwiddle<16, 4, 6, 64>>::select();
+ * ```
+ */
+template <class... Engines>
+class CCordicEngineSelector {
+    static_assert(sizeof...(Engines) > 0, "At least one engine must be given.");
+
+    static constexpr bool same_configuration() {
+        constexpr unsigned widths[]   = {Engines::In_W...};
+        constexpr unsigned stages[]   = {Engines::nb_stages...};
+        constexpr unsigned lengths[]  = {Engines::max_length...};
+        constexpr unsigned integers[] = {Engines::In_I...};
+        for (size_t i = 1; i < sizeof...(Engines); i++) {
+            if (widths[i] != widths[0] || stages[i] != stages[0] || lengths[i] != lengths[0] || integers[i] != integers[0]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    struct selection {
+        std::unique_ptr<CCordicRotator> rotator;
+        std::vector<engine_report>      reports;
+        size_t                          selected;
+    };
+
+    static selection select(size_t length = 1U << 14, unsigned repetitions = 5) {
+        static_assert(same_configuration(), "Engines must share the same configuration.");
+
+        std::unique_ptr<CCordicRotator> rotators[] = {std::unique_ptr<CCordicRotator>(new CCordicRotatorInstance<Engines>())...};
+        const char *                    names[]    = {engine_name<Engines>::get()...};
+
+        const CCordicRotator & first = *rotators[0];
+
+        std::vector<int32_t>  re_in(length), im_in(length), re_out(length), im_out(length);
+        std::vector<uint32_t> counters(length);
+
+        // Symmetric range: the CORDIC pi-rotation can't negate the most negative input.
+        const double  in_scale = double(1ULL << (first.In_W - first.In_I));
+        const int64_t in_max   = (int64_t(1) << (first.In_W - 1)) - 1;
+        rcr::lcg      rng;
+        for (size_t i = 0; i < length; i++) {
+            re_in[i]    = int32_t(rng.uniform(-in_max, in_max));
+            im_in[i]    = int32_t(rng.uniform(-in_max, in_max));
+            counters[i] = uint32_t(i % first.max_length);
+        }
+
+        selection result;
+        result.selected = 0;
+
+        for (size_t e = 0; e < sizeof...(Engines); e++) {
+            const CCordicRotator & rotator = *rotators[e];
+
+            double best_ns = std::numeric_limits<double>::infinity();
+            for (unsigned r = 0; r < repetitions; r++) {
+                const auto start = std::chrono::steady_clock::now();
+                rotator.cordic(re_in.data(), im_in.data(), counters.data(), re_out.data(), im_out.data(), length);
+                const auto stop = std::chrono::steady_clock::now();
+
+                best_ns = std::min(best_ns, std::chrono::duration<double, std::nano>(stop - start).count() / double(length));
+            }
+
+            const double kn        = rcr::kn_values[rotator.nb_stages - 1];
+            const double out_scale = double(1ULL << (rotator.Out_W - rotator.Out_I));
+            const double step      = rcr::rom_rotation(rotator.divider) / double(rotator.q);
+
+            double signal = 0., noise = 0., max_error = 0.;
+            for (size_t i = 0; i < length; i++) {
+                const std::complex<double> expected = std::complex<double>(re_in[i] / in_scale, im_in[i] / in_scale)
+                                                    * std::polar(1., step * double(counters[i]));
+                const std::complex<double> obtained(re_out[i] * kn / out_scale, im_out[i] * kn / out_scale);
+
+                const double error = std::abs(obtained - expected);
+                signal += std::norm(expected);
+                noise += error * error;
+                max_error = std::max(max_error, error);
+            }
+
+            result.reports.push_back({names[e], best_ns, max_error, noise > 0. ? 10. * std::log10(signal / noise) : INFINITY});
+
+            if (best_ns < result.reports[result.selected].ns_per_sample) {
+                result.selected = e;
+            }
+        }
+
+        result.rotator = std::move(rotators[result.selected]);
+        return result;
+    }
+};
+
+#endif // C_CORDIC_ENGINE_SELECTOR_HPP
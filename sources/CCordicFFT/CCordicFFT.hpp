@@ -0,0 +1,200 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_FFT_HPP
+#define C_CORDIC_FFT_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+#include <ap_int.h>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+enum class fft_scaling {
+    per_stage,           ///< Divide by the radix at each stage, the block exponent is always log2(N).
+    block_floating_point ///< Only shift what is needed for the stage outputs to fit `In_W` bits.
+};
+
+/**
+ * @brief In-place fixed-point FFT whose twiddle multiplies are ROM-based CORDIC rotations.
+ *
+ * `Cordic` is any rotator with the static interface of `CCordicRotateConstexpr` whose address grid
+ * contains the N-th roots of unity, i.e. `max_length` must be a multiple of `N`.
+ * Samples are the raw values of `ap_int<In_W>` stored in `int32_t`. Stages are radix-4 (plus one
+ * radix-2 stage when log2(N) is odd) when `Tradix` is 4, radix-2 otherwise.
+ * Between stages, data is kept on `In_W` bits according to `Tscaling`, shifts being rounded half-up.
+ */
+template <class Cordic, unsigned N, fft_scaling Tscaling = fft_scaling::block_floating_point, unsigned Tradix = 4>
+class CCordicFFT {
+    static_assert(N > 1 && rcr::is_pow_2<N>(), "N must be a power of 2.");
+    static_assert(Cordic::max_length % N == 0, "The CORDIC address grid must contain the N-th roots of unity.");
+    static_assert(Tradix == 2 || Tradix == 4, "Only radix-2 and radix-4 are supported.");
+    static_assert(Cordic::In_W <= 30, "Samples must fit int32_t with a growth bit.");
+
+public:
+    static constexpr unsigned length     = N;
+    static constexpr unsigned log2_N     = rcr::needed_bits<N>() - 1;
+    static constexpr unsigned radix      = Tradix;
+    static constexpr unsigned In_W       = Cordic::In_W;
+    static constexpr unsigned Out_W      = Cordic::Out_W;
+    static constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+    static constexpr unsigned gain_frac  = 16;
+    static constexpr int64_t  gain_fixed = int64_t(rcr::kn_values[Cordic::nb_stages - 1] * double(1ULL << gain_frac) + 0.5);
+
+    static constexpr fft_scaling scaling = Tscaling;
+
+private:
+    static int64_t round_shift(int64_t value, unsigned shift) {
+        return shift == 0 ? value : (value + (int64_t(1) << (shift - 1))) >> shift;
+    }
+
+    /// `x * exp(-2j * pi * k / M)`, through the CORDIC then compensated for its gain.
+    static void twiddle(int64_t & re, int64_t & im, unsigned k, unsigned M) {
+        if (k == 0) {
+            return;
+        }
+        const unsigned address = Cordic::max_length - k * (Cordic::max_length / M);
+
+        ap_int<Out_W> re_out, im_out;
+        Cordic::cordic(ap_int<In_W>(re), ap_int<In_W>(im), ap_uint<Cordic::addr_length>(address), re_out, im_out);
+
+        re = round_shift(re_out.to_int64() * gain_fixed, gain_frac);
+        im = round_shift(im_out.to_int64() * gain_fixed, gain_frac);
+    }
+
+    static void radix2_stage(int64_t * re, int64_t * im, unsigned h) {
+        for (unsigned b = 0; b < N; b += 2 * h) {
+            for (unsigned j = 0; j < h; j++) {
+                int64_t t_re = re[b + j + h];
+                int64_t t_im = im[b + j + h];
+                twiddle(t_re, t_im, j, 2 * h);
+
+                const int64_t a_re = re[b + j];
+                const int64_t a_im = im[b + j];
+
+                re[b + j]     = a_re + t_re;
+                im[b + j]     = a_im + t_im;
+                re[b + j + h] = a_re - t_re;
+                im[b + j + h] = a_im - t_im;
+            }
+        }
+    }
+
+    // Two consecutive radix-2 stages (h and 2h) merged: 3 twiddles per 4 samples instead of 4.
+    static void radix4_stage(int64_t * re, int64_t * im, unsigned h) {
+        for (unsigned b = 0; b < N; b += 4 * h) {
+            for (unsigned j = 0; j < h; j++) {
+                const unsigned i0 = b + j, i1 = i0 + h, i2 = i1 + h, i3 = i2 + h;
+
+                int64_t t1_re = re[i1], t1_im = im[i1];
+                int64_t t2_re = re[i2], t2_im = im[i2];
+                int64_t t3_re = re[i3], t3_im = im[i3];
+                twiddle(t1_re, t1_im, 2 * j, 4 * h);
+                twiddle(t2_re, t2_im, j, 4 * h);
+                twiddle(t3_re, t3_im, 3 * j, 4 * h);
+
+                const int64_t s_re = re[i0] + t1_re, s_im = im[i0] + t1_im;
+                const int64_t d_re = re[i0] - t1_re, d_im = im[i0] - t1_im;
+                const int64_t p_re = t2_re + t3_re, p_im = t2_im + t3_im;
+                const int64_t m_re = t2_re - t3_re, m_im = t2_im - t3_im;
+
+                // -j * m = (m_im, -m_re)
+                re[i0] = s_re + p_re;
+                im[i0] = s_im + p_im;
+                re[i1] = d_re + m_im;
+                im[i1] = d_im - m_re;
+                re[i2] = s_re - p_re;
+                im[i2] = s_im - p_im;
+                re[i3] = d_re - m_im;
+                im[i3] = d_im + m_re;
+            }
+        }
+    }
+
+    /// Bring the stage outputs back on `In_W` bits, returns the applied shift.
+    static unsigned normalize(int64_t * re, int64_t * im, unsigned stage_bits) {
+        constexpr int64_t sat = in_max; // std::min / std::max take references
+
+        unsigned shift = stage_bits;
+        if (scaling == fft_scaling::block_floating_point) {
+            int64_t max_abs = 0;
+            for (unsigned n = 0; n < N; n++) {
+                max_abs = std::max(max_abs, std::max(std::abs(re[n]), std::abs(im[n])));
+            }
+            shift = 0;
+            while (round_shift(max_abs, shift) > sat) {
+                shift++;
+            }
+        }
+
+        for (unsigned n = 0; n < N; n++) {
+            re[n] = std::min(sat, std::max(-sat, round_shift(re[n], shift)));
+            im[n] = std::min(sat, std::max(-sat, round_shift(im[n], shift)));
+        }
+        return shift;
+    }
+
+public:
+    /**
+     * @brief Forward DFT, `X[k] = sum_n x[n] exp(-2j pi k n / N)`, computed in place.
+     *
+     * Inputs must lie in `[-(2^(In_W-1) - 1); 2^(In_W-1) - 1]`.
+     * @return the block exponent `e`, such that `X[k] = (re[k] + j im[k]) * 2^e`.
+     */
+    static int forward(int32_t * re, int32_t * im) {
+        int64_t wre[N], wim[N];
+
+        for (unsigned n = 0; n < N; n++) {
+            unsigned reversed = 0;
+            for (unsigned b = 0; b < log2_N; b++) {
+                reversed |= ((n >> b) & 1U) << (log2_N - 1 - b);
+            }
+            wre[reversed] = re[n];
+            wim[reversed] = im[n];
+        }
+
+        int      exponent = 0;
+        unsigned h        = 1;
+        if (radix == 2 || (log2_N & 1U) == 1U) {
+            radix2_stage(wre, wim, h);
+            exponent += int(normalize(wre, wim, 1));
+            h *= 2;
+        }
+        for (; h < N; h *= radix) {
+            if (radix == 4) {
+                radix4_stage(wre, wim, h);
+            } else {
+                radix2_stage(wre, wim, h);
+            }
+            exponent += int(normalize(wre, wim, radix == 4 ? 2 : 1));
+        }
+
+        for (unsigned n = 0; n < N; n++) {
+            re[n] = int32_t(wre[n]);
+            im[n] = int32_t(wim[n]);
+        }
+        return exponent;
+    }
+};
+
+#endif // C_CORDIC_FFT_HPP
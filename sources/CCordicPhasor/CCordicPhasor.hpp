@@ -0,0 +1,117 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_PHASOR_HPP
+#define C_CORDIC_PHASOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <ap_int.h>
+
+/**
+ * @brief Sample with pending rotations, applied by a single CORDIC pass when its value is read.
+ *
+ * `Cordic` is `CCordicRotateConstexpr` or a generated `CCordicRotateRom`: their ROM addresses
+ * span a whole turn in `max_length` steps, so that rotations on the same grid compose by adding
+ * their addresses modulo `max_length`. Chaining a phase offset, a frequency ramp and a per-symbol
+ * correction then costs one CORDIC pass instead of three, and only adds the error of one pass.
+ * ``` C++
+ * CCordicPhasor<cordic> x(re, im);
+ * x.rotate(offset).rotate(ramp).rotate_back(correction);
+ * x.evaluate(re_out, im_out);
+ * ```
+ */
+template <class Cordic>
+class CCordicPhasor {
+public:
+    static constexpr unsigned In_W       = Cordic::In_W;
+    static constexpr unsigned Out_W      = Cordic::Out_W;
+    static constexpr unsigned max_length = Cordic::max_length;
+
+private:
+    ap_int<In_W> re;
+    ap_int<In_W> im;
+    uint64_t     address_sum; // Sum of the pending rotations, modulo max_length.
+    unsigned     nb_pending;
+
+public:
+    CCordicPhasor(const ap_int<In_W> & re, const ap_int<In_W> & im)
+        : re(re), im(im), address_sum(0), nb_pending(0) {}
+
+    /// Address of the rotation by `a` then by `b`.
+    static constexpr uint64_t compose(uint64_t a, uint64_t b) {
+        return (a % max_length + b % max_length) % max_length;
+    }
+
+    /// Address of the inverse rotation.
+    static constexpr uint64_t inverse(uint64_t a) {
+        return (max_length - a % max_length) % max_length;
+    }
+
+    /// Queue a rotation by `counter` ROM steps.
+    CCordicPhasor & rotate(uint64_t counter) {
+        address_sum = compose(address_sum, counter);
+        nb_pending++;
+        return *this;
+    }
+
+    /// Queue a rotation by `-counter` ROM steps.
+    CCordicPhasor & rotate_back(uint64_t counter) {
+        return rotate(inverse(counter));
+    }
+
+    /// Sum of the pending rotations, the single address `evaluate` rotates by.
+    uint64_t address() const {
+        return address_sum;
+    }
+
+    /// Rotations queued since construction, each of which would otherwise be a CORDIC pass.
+    unsigned pending_rotations() const {
+        return nb_pending;
+    }
+
+    /// Run the single CORDIC pass; the outputs are those of `Cordic::cordic` at the address sum.
+    void evaluate(ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) const {
+        Cordic::cordic(re, im, ap_uint<Cordic::addr_length>(address_sum), re_out, im_out);
+    }
+
+    /**
+     * @brief Rotate a block by the sum of `nb_rotations` address streams, one CORDIC pass per sample.
+     *
+     * `counters[r][i]` is the address of the `r`-th rotation applied to the sample `i`.
+     */
+    static void evaluate(const int32_t * re_in, const int32_t * im_in,
+                         const uint32_t * const * counters, size_t nb_rotations,
+                         int32_t * re_out, int32_t * im_out, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            uint64_t sum = 0;
+            for (size_t r = 0; r < nb_rotations; r++) {
+                sum = compose(sum, counters[r][i]);
+            }
+
+            ap_int<Out_W> re, im;
+            Cordic::cordic(ap_int<In_W>(re_in[i]), ap_int<In_W>(im_in[i]), ap_uint<Cordic::addr_length>(sum), re, im);
+            re_out[i] = int32_t(re.to_int64());
+            im_out[i] = int32_t(im.to_int64());
+        }
+    }
+};
+
+#endif // C_CORDIC_PHASOR_HPP
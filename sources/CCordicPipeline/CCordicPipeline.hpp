@@ -0,0 +1,292 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_PIPELINE_HPP
+#define C_CORDIC_PIPELINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "CCordicPipeline/CSpscRing.hpp"
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+
+template <unsigned Tblock_length>
+struct sample_block {
+    int32_t  re[Tblock_length];
+    int32_t  im[Tblock_length];
+    uint32_t length;       ///< Valid samples, 0 marks the end of the stream.
+    uint32_t counter;      ///< Rotation counter of the first sample.
+    uint64_t sequence;     ///< Block index in the stream.
+    int64_t  timestamp_ns; ///< Steady clock time at which the block left the source.
+};
+
+struct pipeline_stats {
+    uint64_t blocks;             ///< Blocks delivered to the sink.
+    uint64_t samples;            ///< Samples delivered to the sink.
+    uint64_t backpressure_waits; ///< Times the reader found the next worker ring full.
+    size_t   max_queue_depth;    ///< Maximum number of blocks in flight, seen by the reader.
+    int64_t  max_latency_ns;     ///< Source to sink, per block.
+    int64_t  mean_latency_ns;
+};
+
+/**
+ * @brief Streaming rotation: reader -> `nb_workers` rotators -> writer, on dedicated threads.
+ *
+ * The reader fills fixed-size blocks from `source` and hands them round-robin to the workers,
+ * each one linked to the reader and to the writer by its own lock-free SPSC ring of `Tdepth` blocks;
+ * the writer collects them in the same order, so the sink receives the samples in order.
+ * Sample `n` of the stream is rotated by `(counter + n) % max_length`.
+ *
+ * When the ring of the next worker is full, the reader stops pulling from the source until a slot
+ * is released (backpressure), which bounds the latency to `nb_workers * 2 * Tdepth` blocks.
+ * Every block and ring is allocated by the constructor: the data path neither locks nor allocates.
+ * The stream ends when `source` returns 0, or after `stop()`.
+ */
+template <class Cordic, unsigned Tblock_length = 256, unsigned Tdepth = 8>
+class CCordicPipeline {
+public:
+    static constexpr unsigned block_length = Tblock_length;
+    static constexpr unsigned depth        = Tdepth;
+
+    typedef sample_block<Tblock_length> block_t;
+    typedef CSpscRing<block_t, Tdepth>  ring_t;
+
+    /// Fill up to `max_length` samples, returns how many were written (0 ends the stream).
+    typedef std::function<size_t(int32_t * re, int32_t * im, size_t max_length)> source_t;
+    typedef std::function<void(const int32_t * re, const int32_t * im, size_t length)> sink_t;
+
+private:
+    const unsigned nb_workers;
+    const uint32_t first_counter;
+
+    source_t source;
+    sink_t   sink;
+
+    const CCordicRotatorInstance<Cordic> rotator;
+
+    std::vector<std::unique_ptr<ring_t>> to_workers;
+    std::vector<std::unique_ptr<ring_t>> to_writer;
+    std::vector<std::thread>             threads;
+
+    std::atomic<bool> stop_requested;
+
+    std::atomic<uint64_t> blocks;
+    std::atomic<uint64_t> samples;
+    std::atomic<uint64_t> backpressure_waits;
+    std::atomic<size_t>   max_queue_depth;
+    std::atomic<int64_t>  max_latency_ns;
+    std::atomic<int64_t>  total_latency_ns;
+
+    static int64_t now_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static block_t * wait_write(ring_t & ring) {
+        block_t * b;
+        while ((b = ring.write_slot()) == nullptr) {
+            std::this_thread::yield();
+        }
+        return b;
+    }
+
+    static block_t * wait_read(ring_t & ring) {
+        block_t * b;
+        while ((b = ring.read_slot()) == nullptr) {
+            std::this_thread::yield();
+        }
+        return b;
+    }
+
+    void reader() {
+        uint32_t counter  = first_counter % Cordic::max_length;
+        uint64_t sequence = 0;
+        unsigned w        = 0;
+
+        for (;;) {
+            ring_t & ring = *to_workers[w];
+
+            block_t * b = ring.write_slot();
+            if (b == nullptr) {
+                backpressure_waits.fetch_add(1, std::memory_order_relaxed);
+                b = wait_write(ring);
+            }
+
+            const size_t n = stop_requested.load(std::memory_order_relaxed) ? 0 : source(b->re, b->im, Tblock_length);
+
+            b->length       = uint32_t(n);
+            b->counter      = counter;
+            b->sequence     = sequence++;
+            b->timestamp_ns = now_ns();
+            ring.commit();
+
+            const size_t in_flight = queue_depth();
+            if (in_flight > max_queue_depth.load(std::memory_order_relaxed)) {
+                max_queue_depth.store(in_flight, std::memory_order_relaxed);
+            }
+
+            if (n == 0) {
+                // The writer expects the next block from worker w: it gets the end mark first.
+                for (unsigned k = 1; k < nb_workers; k++) {
+                    ring_t &  other = *to_workers[(w + k) % nb_workers];
+                    block_t * e     = wait_write(other);
+                    e->length       = 0;
+                    other.commit();
+                }
+                return;
+            }
+
+            counter = uint32_t((uint64_t(counter) + n) % Cordic::max_length);
+            w       = (w + 1) % nb_workers;
+        }
+    }
+
+    void worker(unsigned w) {
+        ring_t & in  = *to_workers[w];
+        ring_t & out = *to_writer[w];
+
+        for (;;) {
+            const block_t * b = wait_read(in);
+            block_t *       o = wait_write(out);
+
+            o->length       = b->length;
+            o->counter      = b->counter;
+            o->sequence     = b->sequence;
+            o->timestamp_ns = b->timestamp_ns;
+            rotator.cordic(b->re, b->im, b->counter, o->re, o->im, b->length);
+
+            const bool last = b->length == 0;
+            in.release();
+            out.commit();
+            if (last) {
+                return;
+            }
+        }
+    }
+
+    void writer() {
+        uint64_t nb_blocks = 0, nb_samples = 0;
+        int64_t  max_latency = 0, total_latency = 0;
+
+        for (unsigned w = 0;; w = (w + 1) % nb_workers) {
+            ring_t &        ring = *to_writer[w];
+            const block_t * b    = wait_read(ring);
+
+            if (b->length == 0) {
+                ring.release();
+                return;
+            }
+
+            sink(b->re, b->im, b->length);
+
+            const int64_t latency = now_ns() - b->timestamp_ns;
+            max_latency           = latency > max_latency ? latency : max_latency;
+            total_latency += latency;
+            nb_samples += b->length;
+            nb_blocks++;
+            ring.release();
+
+            max_latency_ns.store(max_latency, std::memory_order_relaxed);
+            total_latency_ns.store(total_latency, std::memory_order_relaxed);
+            samples.store(nb_samples, std::memory_order_relaxed);
+            blocks.store(nb_blocks, std::memory_order_release);
+        }
+    }
+
+public:
+    CCordicPipeline(unsigned nb_workers, source_t source, sink_t sink, uint32_t counter = 0)
+        : nb_workers(nb_workers > 0 ? nb_workers : 1),
+          first_counter(counter),
+          source(std::move(source)),
+          sink(std::move(sink)),
+          rotator(),
+          stop_requested(false),
+          blocks(0),
+          samples(0),
+          backpressure_waits(0),
+          max_queue_depth(0),
+          max_latency_ns(0),
+          total_latency_ns(0) {
+        for (unsigned w = 0; w < this->nb_workers; w++) {
+            to_workers.emplace_back(new ring_t);
+            to_writer.emplace_back(new ring_t);
+        }
+    }
+
+    CCordicPipeline(const CCordicPipeline &) = delete;
+    CCordicPipeline & operator=(const CCordicPipeline &) = delete;
+
+    ~CCordicPipeline() {
+        stop();
+        wait();
+    }
+
+    /// Launch the reader, the workers and the writer. A pipeline runs once.
+    void start() {
+        if (!threads.empty()) {
+            return;
+        }
+        threads.reserve(nb_workers + 2);
+        threads.emplace_back(&CCordicPipeline::writer, this);
+        for (unsigned w = 0; w < nb_workers; w++) {
+            threads.emplace_back(&CCordicPipeline::worker, this, w);
+        }
+        threads.emplace_back(&CCordicPipeline::reader, this);
+    }
+
+    /// End the stream after the block being read; already read blocks are still delivered.
+    void stop() {
+        stop_requested.store(true, std::memory_order_relaxed);
+    }
+
+    /// Wait for the end of the stream, i.e. until the sink received every block.
+    void wait() {
+        for (std::thread & t : threads) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+    }
+
+    /// Blocks currently in the rings, from the reader to the writer.
+    size_t queue_depth() const {
+        size_t depth = 0;
+        for (unsigned w = 0; w < nb_workers; w++) {
+            depth += to_workers[w]->size() + to_writer[w]->size();
+        }
+        return depth;
+    }
+
+    pipeline_stats stats() const {
+        const uint64_t nb_blocks = blocks.load(std::memory_order_acquire);
+        return {nb_blocks,
+                samples.load(std::memory_order_relaxed),
+                backpressure_waits.load(std::memory_order_relaxed),
+                max_queue_depth.load(std::memory_order_relaxed),
+                max_latency_ns.load(std::memory_order_relaxed),
+                nb_blocks > 0 ? total_latency_ns.load(std::memory_order_relaxed) / int64_t(nb_blocks) : 0};
+    }
+};
+
+#endif // C_CORDIC_PIPELINE_HPP
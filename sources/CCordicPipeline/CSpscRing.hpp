@@ -0,0 +1,100 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_SPSC_RING_HPP
+#define C_SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief Lock-free single-producer / single-consumer ring of `Tcapacity` preallocated slots.
+ *
+ * Slots are filled and consumed in place: the producer fills `write_slot()` then `commit()`s it,
+ * the consumer reads `read_slot()` then `release()`s it, so no element is ever copied nor allocated
+ * once the ring is built. Exactly one thread may produce and one thread may consume.
+ */
+template <class T, unsigned Tcapacity>
+class CSpscRing {
+    static_assert(rcr::is_pow_2<Tcapacity>(), "Ring capacity must be a power of 2.");
+
+public:
+    static constexpr unsigned capacity = Tcapacity;
+
+private:
+    static constexpr size_t cache_line = 64;
+
+    std::unique_ptr<T[]> slots;
+
+    // Both indexes live on their own cache line, to avoid false sharing between the two threads.
+    // Padding rather than alignas: over-aligned allocations are only honored from C++17.
+    char                  pad_0[cache_line];
+    std::atomic<uint64_t> head; // Next slot to read, written by the consumer.
+    char                  pad_1[cache_line - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> tail; // Next slot to write, written by the producer.
+    char                  pad_2[cache_line - sizeof(std::atomic<uint64_t>)];
+
+public:
+    CSpscRing() : slots(new T[Tcapacity]), pad_0(), head(0), pad_1(), tail(0), pad_2() {}
+
+    CSpscRing(const CSpscRing &) = delete;
+    CSpscRing & operator=(const CSpscRing &) = delete;
+
+    /// Producer side: next free slot, or nullptr if the ring is full.
+    T * write_slot() {
+        const uint64_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Tcapacity) {
+            return nullptr;
+        }
+        return &slots[t & (Tcapacity - 1)];
+    }
+
+    /// Producer side: publish the slot returned by `write_slot()`.
+    void commit() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// Consumer side: oldest published slot, or nullptr if the ring is empty.
+    T * read_slot() {
+        const uint64_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots[h & (Tcapacity - 1)];
+    }
+
+    /// Consumer side: give the slot returned by `read_slot()` back to the producer.
+    void release() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /// Number of published slots, exact only from the producer or the consumer thread.
+    size_t size() const {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        return size_t(tail.load(std::memory_order_acquire) - h);
+    }
+};
+
+#endif // C_SPSC_RING_HPP
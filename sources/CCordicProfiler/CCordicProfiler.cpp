@@ -0,0 +1,336 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicProfiler.hpp"
+
+#if defined(CORDIC_PROFILING) && !defined(__SYNTHESIS__)
+
+#include <cstring>
+#include <mutex>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+enum class counters_state : uint8_t {
+    closed      = 0,
+    open        = 1,
+    unavailable = 2
+};
+
+// Statistics of the threads that exited, and of the sites past `max_sites`.
+struct site_totals {
+    uint64_t calls;
+    uint64_t timed_calls;
+    uint64_t samples;
+    uint64_t cycles;
+    uint64_t counted_calls;
+    uint64_t counters[CCordicProfiler::nb_counters];
+    uint64_t histogram[CCordicProfiler::nb_buckets];
+};
+
+} // namespace
+
+struct CCordicProfiler::thread_stats {
+    site_stats     sites[max_sites];
+    counters_state counters;
+    int            counter_fds[nb_counters];
+
+    thread_stats();
+    ~thread_stats();
+};
+
+namespace {
+
+struct profiler_state {
+    std::mutex                                    mutex;
+    std::vector<const char *>                     names;
+    std::vector<CCordicProfiler::thread_stats *> threads;
+    site_totals                                   retired[CCordicProfiler::max_sites];
+    std::atomic<uint64_t>                         period;
+    std::atomic<bool>                             counters_enabled;
+
+    profiler_state() : retired(), period(1), counters_enabled(false) {}
+};
+
+// Never destroyed: threads may exit after the static destructors ran.
+profiler_state & state() {
+    static profiler_state * const s = new profiler_state();
+    return *s;
+}
+
+void accumulate(site_totals & total, const CCordicProfiler::site_stats & s) {
+    total.calls += s.calls.load(std::memory_order_relaxed) + s.armed.load(std::memory_order_relaxed) - s.countdown.load(std::memory_order_relaxed);
+    total.timed_calls += s.timed_calls.load(std::memory_order_relaxed);
+    total.samples += s.samples.load(std::memory_order_relaxed);
+    total.cycles += s.cycles.load(std::memory_order_relaxed);
+    total.counted_calls += s.counted_calls.load(std::memory_order_relaxed);
+    for (unsigned c = 0; c < CCordicProfiler::nb_counters; c++) {
+        total.counters[c] += s.counters[c].load(std::memory_order_relaxed);
+    }
+    for (unsigned b = 0; b < CCordicProfiler::nb_buckets; b++) {
+        total.histogram[b] += s.histogram[b].load(std::memory_order_relaxed);
+    }
+}
+
+void clear(CCordicProfiler::site_stats & s) {
+    // The owning thread keeps its countdown: cancel the calls it holds (modulo 2^64).
+    s.calls.store(s.countdown.load(std::memory_order_relaxed) - s.armed.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    s.timed_calls.store(0, std::memory_order_relaxed);
+    s.samples.store(0, std::memory_order_relaxed);
+    s.cycles.store(0, std::memory_order_relaxed);
+    s.counted_calls.store(0, std::memory_order_relaxed);
+    for (unsigned c = 0; c < CCordicProfiler::nb_counters; c++) {
+        s.counters[c].store(0, std::memory_order_relaxed);
+    }
+    for (unsigned b = 0; b < CCordicProfiler::nb_buckets; b++) {
+        s.histogram[b].store(0, std::memory_order_relaxed);
+    }
+}
+
+#if defined(__linux__)
+// Instructions, cache misses and branch misses of the calling thread, user space only.
+bool open_counters(int fds[CCordicProfiler::nb_counters]) {
+    const uint64_t configs[CCordicProfiler::nb_counters] = {PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    for (unsigned c = 0; c < CCordicProfiler::nb_counters; c++) {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type           = PERF_TYPE_HARDWARE;
+        attr.size           = sizeof(attr);
+        attr.config         = configs[c];
+        attr.read_format    = PERF_FORMAT_GROUP;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+
+        fds[c] = int(syscall(__NR_perf_event_open, &attr, 0, -1, c == 0 ? -1 : fds[0], 0));
+        if (fds[c] < 0) {
+            for (unsigned o = 0; o < c; o++) {
+                close(fds[o]);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+} // namespace
+
+CCordicProfiler::thread_stats::thread_stats() : sites(), counters(counters_state::closed), counter_fds() {
+    for (site_stats & s : sites) {
+        s.countdown.store(1, std::memory_order_relaxed);
+        s.armed.store(1, std::memory_order_relaxed);
+    }
+
+    profiler_state &             global = state();
+    std::lock_guard<std::mutex> lock(global.mutex);
+    global.threads.push_back(this);
+}
+
+CCordicProfiler::thread_stats::~thread_stats() {
+    profiler_state &             global = state();
+    std::lock_guard<std::mutex> lock(global.mutex);
+    for (unsigned id = 0; id < max_sites; id++) {
+        accumulate(global.retired[id], sites[id]);
+    }
+    for (size_t t = 0; t < global.threads.size(); t++) {
+        if (global.threads[t] == this) {
+            global.threads.erase(global.threads.begin() + std::ptrdiff_t(t));
+            break;
+        }
+    }
+
+#if defined(__linux__)
+    if (counters == counters_state::open) {
+        for (int fd : counter_fds) {
+            close(fd);
+        }
+    }
+#endif
+}
+
+unsigned CCordicProfiler::register_site(const char * name) {
+    profiler_state &             global = state();
+    std::lock_guard<std::mutex> lock(global.mutex);
+
+    for (size_t id = 0; id < global.names.size(); id++) {
+        if (strcmp(global.names[id], name) == 0) {
+            return unsigned(id);
+        }
+    }
+
+    // The last slot gathers every site past the table.
+    if (global.names.size() == max_sites - 1) {
+        global.names.push_back("(other sites)");
+    }
+    if (global.names.size() == max_sites) {
+        return max_sites - 1;
+    }
+
+    global.names.push_back(name);
+    return unsigned(global.names.size() - 1);
+}
+
+CCordicProfiler::thread_stats & CCordicProfiler::this_thread() {
+    static thread_local thread_stats stats;
+    return stats;
+}
+
+CCordicProfiler::site_stats & CCordicProfiler::site(thread_stats & thread, unsigned id) {
+    return thread.sites[id];
+}
+
+uint64_t CCordicProfiler::sampling_period() {
+    return state().period.load(std::memory_order_relaxed);
+}
+
+void CCordicProfiler::rearm(site_stats & s) {
+    const uint64_t period = sampling_period();
+    add(s.calls, s.armed.load(std::memory_order_relaxed));
+    s.armed.store(period, std::memory_order_relaxed);
+    s.countdown.store(period, std::memory_order_relaxed);
+}
+
+void CCordicProfiler::set_sampling(uint64_t period) {
+    state().period.store(period > 0 ? period : 1, std::memory_order_relaxed);
+}
+
+bool CCordicProfiler::read_counters(thread_stats & thread, uint64_t values[nb_counters]) {
+#if defined(__linux__)
+    if (!state().counters_enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    if (thread.counters == counters_state::closed) {
+        thread.counters = open_counters(thread.counter_fds) ? counters_state::open : counters_state::unavailable;
+    }
+    if (thread.counters != counters_state::open) {
+        return false;
+    }
+
+    uint64_t group[1 + nb_counters];
+    if (read(thread.counter_fds[0], group, sizeof(group)) != ssize_t(sizeof(group)) || group[0] != nb_counters) {
+        return false;
+    }
+    for (unsigned c = 0; c < nb_counters; c++) {
+        values[c] = group[1 + c];
+    }
+    return true;
+#else
+    (void) thread;
+    (void) values;
+    return false;
+#endif
+}
+
+bool CCordicProfiler::enable_counters(bool enable) {
+    state().counters_enabled.store(enable, std::memory_order_relaxed);
+    if (!enable) {
+        return false;
+    }
+
+    uint64_t values[nb_counters];
+    return read_counters(this_thread(), values);
+}
+
+std::vector<profile_report> CCordicProfiler::snapshot() {
+    profiler_state &             global = state();
+    std::lock_guard<std::mutex> lock(global.mutex);
+
+    std::vector<profile_report> reports;
+    for (size_t id = 0; id < global.names.size(); id++) {
+        site_totals total = global.retired[id];
+        for (const thread_stats * thread : global.threads) {
+            accumulate(total, thread->sites[id]);
+        }
+
+        profile_report r;
+        r.name          = global.names[id];
+        r.calls         = total.calls;
+        r.timed_calls   = total.timed_calls;
+        r.samples       = total.samples;
+        r.cycles        = total.cycles;
+        r.histogram     = std::vector<uint64_t>(total.histogram, total.histogram + nb_buckets);
+        r.has_counters  = total.counted_calls > 0;
+        r.counted_calls = total.counted_calls;
+        r.instructions  = total.counters[0];
+        r.cache_misses  = total.counters[1];
+        r.branch_misses = total.counters[2];
+        reports.push_back(r);
+    }
+    return reports;
+}
+
+void CCordicProfiler::dump(FILE * stream) {
+    const std::vector<profile_report> reports = snapshot();
+
+    fprintf(stream, "%-40s %12s %12s %12s %12s %12s %10s %10s %10s\n",
+            "site", "calls", "timed", "cycles/call", "cycles/smpl", "p50<,p90<", "instr/call", "cmiss/call", "bmiss/call");
+
+    for (const profile_report & r : reports) {
+        if (r.timed_calls == 0) {
+            fprintf(stream, "%-40s %12llu %12s\n", r.name, (unsigned long long) r.calls, "0");
+            continue;
+        }
+
+        // Upper bounds of the buckets holding the median and the 90th percentile.
+        unsigned p50 = 0, p90 = 0;
+        uint64_t seen = 0;
+        for (unsigned b = 0; b < nb_buckets; b++) {
+            seen += r.histogram[b];
+            p50 = 2 * seen <= r.timed_calls ? b + 1 : p50;
+            p90 = 10 * seen <= 9 * r.timed_calls ? b + 1 : p90;
+        }
+
+        char percentiles[32];
+        snprintf(percentiles, sizeof(percentiles), "2^%u,2^%u", p50 + 1, p90 + 1);
+
+        const double calls = double(r.timed_calls);
+        fprintf(stream, "%-40s %12llu %12llu %12.1f %12.2f %12s",
+                r.name, (unsigned long long) r.calls, (unsigned long long) r.timed_calls,
+                double(r.cycles) / calls, r.samples > 0 ? double(r.cycles) / double(r.samples) : 0., percentiles);
+        if (r.has_counters) {
+            const double counted = double(r.counted_calls);
+            fprintf(stream, " %10.1f %10.2f %10.2f\n", double(r.instructions) / counted, double(r.cache_misses) / counted, double(r.branch_misses) / counted);
+        } else {
+            fprintf(stream, " %10s %10s %10s\n", "-", "-", "-");
+        }
+    }
+}
+
+void CCordicProfiler::reset() {
+    profiler_state &             global = state();
+    std::lock_guard<std::mutex> lock(global.mutex);
+
+    for (site_totals & total : global.retired) {
+        total = site_totals();
+    }
+    for (thread_stats * thread : global.threads) {
+        for (site_stats & s : thread->sites) {
+            clear(s);
+        }
+    }
+}
+
+#endif // CORDIC_PROFILING
@@ -0,0 +1,213 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_PROFILER_HPP
+#define C_CORDIC_PROFILER_HPP
+
+/**
+ * @file CCordicProfiler.hpp
+ * Per-call-site cycle histograms and hardware counters of the rotator entry points.
+ *
+ * Entry points open a `CORDIC_PROFILE_SCOPE(name, samples)`, which expands to nothing unless
+ * `CORDIC_PROFILING` is defined (CMake option of the same name). When compiled in, every call is
+ * counted, and one call in `sampling period` of each site is timed with the TSC (and, once
+ * enabled, with Linux `perf_event_open` counters), in per-thread tables aggregated on demand.
+ */
+
+#if defined(CORDIC_PROFILING) && !defined(__SYNTHESIS__)
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#else
+#include <chrono>
+#endif
+
+struct profile_report {
+    const char *          name;
+    uint64_t              calls;
+    uint64_t              timed_calls;
+    uint64_t              samples;    ///< Samples processed by the timed calls.
+    uint64_t              cycles;     ///< Sum over the timed calls.
+    std::vector<uint64_t> histogram;  ///< Timed calls per `floor(log2(cycles))`.
+    bool                  has_counters;
+    uint64_t              counted_calls; ///< Timed calls for which the hardware counters were read.
+    uint64_t              instructions;
+    uint64_t              cache_misses;
+    uint64_t              branch_misses;
+};
+
+class CCordicProfiler {
+public:
+    static constexpr bool     enabled     = true;
+    static constexpr unsigned max_sites   = 64;
+    static constexpr unsigned nb_buckets  = 48;
+    static constexpr unsigned nb_counters = 3;
+
+    // Single writer (the owning thread), relaxed readers (the aggregation).
+    struct site_stats {
+        std::atomic<uint64_t> calls;
+        std::atomic<uint64_t> timed_calls;
+        std::atomic<uint64_t> samples;
+        std::atomic<uint64_t> cycles;
+        std::atomic<uint64_t> counted_calls;
+        std::atomic<uint64_t> counters[nb_counters];
+        std::atomic<uint64_t> histogram[nb_buckets];
+        std::atomic<uint64_t> countdown; ///< Calls left before the next timed one.
+        std::atomic<uint64_t> armed;     ///< Countdown at the last timed call: `calls` lags by `armed - countdown`.
+    };
+
+    struct thread_stats;
+
+    static uint64_t timestamp() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    static void add(std::atomic<uint64_t> & counter, uint64_t value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    /// Id of the site `name`, the same for every call site sharing the name.
+    static unsigned register_site(const char * name);
+
+    static thread_stats & this_thread();
+    static site_stats &   site(thread_stats & thread, unsigned id);
+    static uint64_t       sampling_period();
+
+    /// Fold the calls counted down into `calls`, and restart the countdown of the calling thread.
+    static void rearm(site_stats & s);
+
+    /// Reads the hardware counters of the calling thread, returns false when not available.
+    static bool read_counters(thread_stats & thread, uint64_t values[nb_counters]);
+
+    /// Time one call in `period` per site and thread (1, the default, times every call).
+    static void set_sampling(uint64_t period);
+
+    /// Enable the `perf_event_open` counters, returns false when the kernel refuses them.
+    static bool enable_counters(bool enable);
+
+    static std::vector<profile_report> snapshot();
+    static void                        dump(FILE * stream = stderr);
+
+    /// Clear the statistics of every thread; sites stay registered.
+    static void reset();
+};
+
+/// RAII timer of a call site, see `CORDIC_PROFILE_SCOPE`.
+class CCordicProfileScope {
+    CCordicProfiler::thread_stats * thread;
+    CCordicProfiler::site_stats *   stats;
+    uint64_t                        samples;
+    uint64_t                        start;
+    bool                            counting;
+    uint64_t                        counters_start[CCordicProfiler::nb_counters];
+
+public:
+    // `s` belongs to the calling thread: untimed calls only count it down.
+    CCordicProfileScope(CCordicProfiler::site_stats & s, uint64_t samples) : thread(nullptr), stats(nullptr), samples(samples), start(0), counting(false) {
+        const uint64_t left = s.countdown.load(std::memory_order_relaxed) - 1;
+        s.countdown.store(left, std::memory_order_relaxed);
+        if (left != 0) {
+            return;
+        }
+        CCordicProfiler::rearm(s);
+
+        thread   = &CCordicProfiler::this_thread();
+        stats    = &s;
+        counting = CCordicProfiler::read_counters(*thread, counters_start);
+        start    = CCordicProfiler::timestamp();
+    }
+
+    ~CCordicProfileScope() {
+        if (stats == nullptr) {
+            return;
+        }
+        const uint64_t cycles = CCordicProfiler::timestamp() - start;
+
+        uint64_t counters_stop[CCordicProfiler::nb_counters];
+        if (counting && CCordicProfiler::read_counters(*thread, counters_stop)) {
+            for (unsigned c = 0; c < CCordicProfiler::nb_counters; c++) {
+                CCordicProfiler::add(stats->counters[c], counters_stop[c] - counters_start[c]);
+            }
+            CCordicProfiler::add(stats->counted_calls, 1);
+        }
+
+        unsigned bucket = 0;
+        while ((cycles >> (bucket + 1)) != 0 && bucket + 1 < CCordicProfiler::nb_buckets) {
+            bucket++;
+        }
+
+        CCordicProfiler::add(stats->timed_calls, 1);
+        CCordicProfiler::add(stats->samples, samples);
+        CCordicProfiler::add(stats->cycles, cycles);
+        CCordicProfiler::add(stats->histogram[bucket], 1);
+    }
+
+    CCordicProfileScope(const CCordicProfileScope &) = delete;
+    CCordicProfileScope & operator=(const CCordicProfileScope &) = delete;
+};
+
+#define CORDIC_PROFILE_CONCAT_(a, b) a##b
+#define CORDIC_PROFILE_CONCAT(a, b)  CORDIC_PROFILE_CONCAT_(a, b)
+
+#define CORDIC_PROFILE_SCOPE(name, samples)                                                            \
+    static const unsigned     CORDIC_PROFILE_CONCAT(cordic_profile_site_, __LINE__) = CCordicProfiler::register_site(name); \
+    static thread_local CCordicProfiler::site_stats & CORDIC_PROFILE_CONCAT(cordic_profile_stats_, __LINE__)               \
+        = CCordicProfiler::site(CCordicProfiler::this_thread(), CORDIC_PROFILE_CONCAT(cordic_profile_site_, __LINE__));      \
+    const CCordicProfileScope CORDIC_PROFILE_CONCAT(cordic_profile_scope_, __LINE__)(CORDIC_PROFILE_CONCAT(cordic_profile_stats_, __LINE__), uint64_t(samples))
+
+#else
+
+#if !defined(__SYNTHESIS__)
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+struct profile_report {};
+
+/// Compiled-out profiler: no state, and entry points are not instrumented.
+class CCordicProfiler {
+public:
+    static constexpr bool enabled = false;
+
+    static void set_sampling(uint64_t) {}
+    static bool enable_counters(bool) { return false; }
+
+    static std::vector<profile_report> snapshot() { return {}; }
+    static void                        dump(FILE * = stderr) {}
+    static void                        reset() {}
+};
+#endif
+
+#define CORDIC_PROFILE_SCOPE(name, samples) static_cast<void>(0)
+
+#endif // CORDIC_PROFILING
+
+#endif // C_CORDIC_PROFILER_HPP
@@ -30,16 +30,17 @@
 #include <ap_fixed.h>
 #include <ap_int.h>
 
+#include "CCordicProfiler/CCordicProfiler.hpp"
 #include "RomGeneratorConst/RomGeneratorConst.hpp"
 
 namespace rcr = rom_cordic_rotate;
 
-template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned divider = 2>
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider = 2>
 class CCordicRotateConstexpr {
     static_assert(TIn_W > 0, "Inputs can't be on zero bits.");
     static_assert(Tnb_stages < 8, "7 stages of CORDIC is the maximum supported.");
     static_assert(Tnb_stages > 1, "2 stages of CORDIC is the minimum.");
-    static_assert(rcr::is_pow_2<divider>(), "divider must be a power of 2.");
+    static_assert(Tq > 0, "q can't be zero.");
 
 public:
     // ``` GNU Octave
@@ -48,20 +49,25 @@ public:
     static constexpr double kn_values[7] = {
         0.70710678118655, 0.632455532033680, 0.613571991077900,
         0.608833912517750, 0.607648256256170, 0.607351770141300, 0.607277644093530};
-    static constexpr const CRomGeneratorConst<TIn_W, Tnb_stages, Tq, divider> & rom_cordic {};
+    static constexpr const CRomGeneratorConst<TIn_W, Tnb_stages, Tq, Tdivider> & rom_cordic {};
 
     static constexpr unsigned In_W      = TIn_W;
     static constexpr unsigned In_I      = TIn_I;
     static constexpr unsigned Out_W     = In_W + 2;
     static constexpr unsigned Out_I     = In_I + 2;
     static constexpr unsigned nb_stages = Tnb_stages;
+    static constexpr unsigned q         = Tq;
+    static constexpr unsigned divider   = Tdivider;
+
+    static constexpr rcr::generator_type rom_type = rcr::generator_type::cst;
 
     static constexpr unsigned kn_i             = unsigned(kn_values[nb_stages - 1] * double(1U << 4)); // 4 bits are enough
     static constexpr unsigned in_scale_factor  = unsigned(1U << (In_W - In_I));
     static constexpr unsigned out_scale_factor = unsigned(1U << (Out_W - Out_I));
 
-    static constexpr double   rotation    = CRomGeneratorConst<TIn_W, Tnb_stages, Tq, divider>::rotation;
-    static constexpr unsigned addr_length = CRomGeneratorConst<TIn_W, Tnb_stages, Tq, divider>::addr_length;
+    static constexpr double   rotation    = CRomGeneratorConst<TIn_W, Tnb_stages, Tq, Tdivider>::rotation;
+    static constexpr unsigned max_length  = CRomGeneratorConst<TIn_W, Tnb_stages, Tq, Tdivider>::max_length;
+    static constexpr unsigned addr_length = CRomGeneratorConst<TIn_W, Tnb_stages, Tq, Tdivider>::addr_length;
 
     static constexpr int64_t scale_cordic(int64_t in) {
         return in * kn_i / 16U;
@@ -107,6 +113,41 @@ public:
         return {scale_cordic(double(fx_out.real())) / double(out_scale_factor), scale_cordic(double(fx_out.imag())) / double(out_scale_factor)};
     }
 
+    static void cordic_dual(std::complex<int64_t> x_in, uint64_t counter,
+                            std::complex<int64_t> & x_pos, std::complex<int64_t> & x_neg) {
+
+        int64_t A = x_in.real();
+        int64_t B = x_in.imag();
+
+        const uint8_t R    = rom_cordic.rom[counter];
+        uint8_t       mask = 0x01;
+        if ((R & mask) == mask) {
+            A = -A;
+            B = -B;
+        }
+
+        // Conjugated path, rotated by the same controls.
+        int64_t C = A;
+        int64_t D = -B;
+
+        for (uint8_t u = 1; u < nb_stages + 1; u++) {
+            mask = mask << 1;
+
+            const int64_t Ri = (R & mask) == mask ? 1 : -1;
+
+            const int64_t I = A + Ri * (B / int64_t(1LU << (u - 1)));
+            B               = B - Ri * (A / int64_t(1LU << (u - 1)));
+            A               = I;
+
+            const int64_t K = C + Ri * (D / int64_t(1LU << (u - 1)));
+            D               = D - Ri * (C / int64_t(1LU << (u - 1)));
+            C               = K;
+        }
+
+        x_pos = {A, B};
+        x_neg = {C, -D};
+    }
+
 #endif
 
     static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in) {
@@ -117,6 +158,7 @@ public:
     static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
                        const ap_uint<addr_length> & counter,
                        ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        CORDIC_PROFILE_SCOPE("CCordicRotateConstexpr::cordic", 1);
 
         const ap_uint<nb_stages + 1> R = rom_cordic.rom[counter];
 
@@ -153,6 +195,153 @@ public:
         im_out = B;
     }
 
+    /// `stages` clamped to `[1, nb_stages]`, as used by every `stages` overload below.
+    static constexpr unsigned clamp_stages(unsigned stages) {
+        return stages < 1 ? 1 : (stages > nb_stages ? nb_stages : stages);
+    }
+
+    /// Integer gain of the first `stages` stages, on 4 fractional bits as `kn_i`.
+    static constexpr unsigned kn_i_of(unsigned stages) {
+        return unsigned(rcr::kn_values[clamp_stages(stages) - 1] * double(1U << 4));
+    }
+
+    static constexpr double scale_cordic(double in, unsigned stages) {
+        return in * rcr::kn_values[clamp_stages(stages) - 1];
+    }
+
+    static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in, unsigned stages) {
+        const ap_int<Out_W + 4> tmp = in * ap_uint<4>(kn_i_of(stages));
+        return ap_int<Out_W>(tmp >> 4);
+    }
+
+    /**
+     * @brief Rotate with the first `stages` stages only, `1 <= stages <= nb_stages`.
+     *
+     * Out-of-range values are clamped by `clamp_stages()`, so that the outputs always match the
+     * gain of `scale_cordic(out, stages)`.
+     *
+     * The ROM words are those of the full rotator, the remaining stages being skipped: outputs
+     * are those of a `stages`-stage rotator driven by the prefixes of the control words, with the
+     * gain of `scale_cordic(out, stages)`. The loop exits after `stages` iterations; once unrolled
+     * by HLS, each stage gets a bypass instead.
+     */
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                       const ap_uint<addr_length> & counter, unsigned stages,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        CORDIC_PROFILE_SCOPE("CCordicRotateConstexpr::cordic(stages)", 1);
+
+        const ap_uint<nb_stages + 1> R = rom_cordic.rom[counter];
+
+        ap_int<Out_W> A = bool(R[0]) ? ap_int<In_W>(-re_in) : re_in;
+        ap_int<Out_W> B = bool(R[0]) ? ap_int<In_W>(-im_in) : im_in;
+
+        const unsigned active_stages = clamp_stages(stages);
+
+        for (uint8_t u = 1; u < nb_stages + 1; u++) {
+            if (u > active_stages) {
+                break;
+            }
+
+            const bool Ri = bool(R[u]);
+
+            const ap_int<Out_W> shifted_A = A >> (u - 1);
+            const ap_int<Out_W> shifted_B = B >> (u - 1);
+
+            const ap_int<Out_W> arc_step_A
+                = Ri
+                    ? ap_int<Out_W>(-shifted_A)
+                    : shifted_A;
+            const ap_int<Out_W> arc_step_B
+                = Ri
+                    ? shifted_B
+                    : ap_int<Out_W>(-shifted_B);
+
+            const ap_int<Out_W + 1> I = A + arc_step_B;
+            B                         = B + arc_step_A;
+            A                         = I;
+        }
+
+        re_out = A;
+        im_out = B;
+    }
+
+    /**
+     * @brief Rotate, then apply the per-address gain correction of the ROM.
+     *
+     * The outputs are directly comparable to `scale_cordic(cordic(...))`, but both the CORDIC gain
+     * and the residual angle of the control word are compensated, so that a few stages
+     * are enough for an accuracy otherwise requiring the maximum stage count.
+     */
+    static void cordic_corrected(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                                 const ap_uint<addr_length> & counter,
+                                 ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        typedef CRomGainConst<In_W, nb_stages, q, divider> gain_rom;
+
+        constexpr int      gain_frac = gain_rom::gain_frac;
+        constexpr int      gain_w    = rcr::gain_bits(gain_frac);
+        static_assert(Out_W + gain_w + 1 <= 64, "Gain correction products must fit on 64 bits.");
+
+        static constexpr gain_rom rom_gain {};
+
+        ap_int<Out_W> A, B;
+        cordic(re_in, im_in, counter, A, B);
+
+        const ap_int<gain_w>             gain_re = rom_gain.gain_re[counter];
+        const ap_int<gain_w>             gain_im = rom_gain.gain_im[counter];
+        const ap_int<gain_frac + 1>      half    = ap_int<gain_frac + 1>(1) << (gain_frac - 1);
+        const ap_int<Out_W + gain_w + 1> re      = A * gain_re - B * gain_im + half;
+        const ap_int<Out_W + gain_w + 1> im      = A * gain_im + B * gain_re + half;
+
+        re_out = ap_int<Out_W>(re >> gain_frac);
+        im_out = ap_int<Out_W>(im >> gain_frac);
+    }
+
+    /**
+     * @brief Rotate the same sample by `+theta` and `-theta` in a single call.
+     *
+     * The `-theta` outputs are bit-exact with `conj(cordic(conj(x)))`, the conjugated input being
+     * negated on `In_W` bits as that call does (so `-2^(In_W - 1)` stays itself). Only the ROM
+     * lookup and the stage controls are shared: after the first stage, the conjugated state is
+     * not the conjugate of the direct one, so every stage shifts and adds both paths.
+     */
+    static void cordic_dual(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                            const ap_uint<addr_length> & counter,
+                            ap_int<Out_W> & re_pos, ap_int<Out_W> & im_pos,
+                            ap_int<Out_W> & re_neg, ap_int<Out_W> & im_neg) {
+
+        const ap_uint<nb_stages + 1> R = rom_cordic.rom[counter];
+
+        ap_int<Out_W> A = bool(R[0]) ? ap_int<In_W>(-re_in) : re_in;
+        ap_int<Out_W> B = bool(R[0]) ? ap_int<In_W>(-im_in) : im_in;
+
+        // Conjugated path, rotated by the same controls.
+        ap_int<Out_W> C = A;
+        ap_int<Out_W> D = ap_int<In_W>(-B);
+
+        for (uint8_t u = 1; u < nb_stages + 1; u++) {
+
+            const bool Ri = bool(R[u]);
+
+            const ap_int<Out_W> shifted_A = A >> (u - 1);
+            const ap_int<Out_W> shifted_B = B >> (u - 1);
+            const ap_int<Out_W> shifted_C = C >> (u - 1);
+            const ap_int<Out_W> shifted_D = D >> (u - 1);
+
+            const ap_int<Out_W + 1> I = Ri ? ap_int<Out_W + 1>(A + shifted_B) : ap_int<Out_W + 1>(A - shifted_B);
+            B                         = Ri ? ap_int<Out_W>(B - shifted_A) : ap_int<Out_W>(B + shifted_A);
+            A                         = I;
+
+            const ap_int<Out_W + 1> K = Ri ? ap_int<Out_W + 1>(C + shifted_D) : ap_int<Out_W + 1>(C - shifted_D);
+            D                         = Ri ? ap_int<Out_W>(D - shifted_C) : ap_int<Out_W>(D + shifted_C);
+            C                         = K;
+        }
+
+        re_pos = A;
+        im_pos = B;
+        re_neg = C;
+        im_neg = -D;
+    }
+
     constexpr CCordicRotateConstexpr() = default;
 };
 
@@ -0,0 +1,251 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_FOLDED_HPP
+#define C_CORDIC_ROTATE_FOLDED_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+struct folded_stats {
+    uint64_t cycles;       ///< Clock cycles simulated.
+    uint64_t samples;      ///< Samples that left the datapath.
+    uint64_t busy_cycles;  ///< Cycles during which the physical stages computed.
+    uint64_t stall_cycles; ///< Cycles lost because an output register was full.
+};
+
+/**
+ * @brief Folded (iterative) counterpart of the unrolled `Cordic` datapath, with its cycle model.
+ *
+ * Only `Tfold` physical stages are instantiated; a sample loops `passes` times through them, the
+ * shift of each physical stage being selected by the pass. `Tchannels` time-interleaved channels
+ * share the datapath: each one has its own input and output registers, served round-robin.
+ *
+ * The modelled hardware is: input registers -> ROM read and pi-rotation register -> ring of
+ * `fold` registered physical stages, travelled `passes` times -> output registers. As in the
+ * unrolled pipeline, every stage takes one cycle, so that the unfolded rotator (`fold ==
+ * nb_stages`) has `unrolled_latency`. Up to `fold` samples share the ring: one enters it every
+ * `ii` cycles and leaves it `latency` cycles after being pushed, when no output register is full.
+ *
+ * `Cordic` must be a `CCordicRotateConstexpr`: its ROM is read directly, and the outputs are
+ * bit-exact with its `ap_int` `cordic` overload.
+ */
+template <class Cordic, unsigned Tfold = 1, unsigned Tchannels = 1>
+class CCordicRotateFolded {
+    static_assert(Tfold > 0 && Tfold <= Cordic::nb_stages, "Between 1 and nb_stages physical stages.");
+    static_assert(Tchannels > 0, "At least one channel must be served.");
+
+public:
+    static constexpr unsigned In_W       = Cordic::In_W;
+    static constexpr unsigned Out_W      = Cordic::Out_W;
+    static constexpr unsigned nb_stages  = Cordic::nb_stages;
+    static constexpr unsigned max_length = Cordic::max_length;
+    static constexpr unsigned fold       = Tfold;
+    static constexpr unsigned channels   = Tchannels;
+
+    static constexpr unsigned passes     = (nb_stages + fold - 1) / fold;
+    static constexpr unsigned ii         = passes;            ///< Cycles between two samples, all channels included.
+    static constexpr unsigned channel_ii = passes * channels; ///< Per channel, when every channel is loaded evenly.
+    static constexpr unsigned latency    = passes * fold + 2;
+    static constexpr unsigned adders     = 2 * (fold + 1);    ///< The pi-rotation negations included.
+    static constexpr unsigned adder_bits = adders * Out_W;
+
+    /// The same counts for the unrolled `Cordic`, one register per stage as `CCordicStreamModel`.
+    static constexpr unsigned unrolled_adders  = 2 * (nb_stages + 1);
+    static constexpr unsigned unrolled_latency = nb_stages + 2;
+
+private:
+    struct stage_register {
+        bool     valid;
+        unsigned channel;
+        uint8_t  R;
+        unsigned pass;
+        int64_t  A;
+        int64_t  B;
+    };
+
+    struct io_register {
+        bool     valid;
+        int64_t  re;
+        int64_t  im;
+        uint32_t counter;
+    };
+
+    io_register    inputs[channels];
+    io_register    outputs[channels];
+    stage_register pre;
+    stage_register loop[fold]; ///< `loop[p]` holds the sample entering physical stage `p`.
+    unsigned       next_channel;
+    folded_stats   statistics;
+
+    static inline int64_t wrap(int64_t value, unsigned width) {
+        const unsigned shift = 64U - width;
+        return int64_t(uint64_t(value) << shift) >> shift;
+    }
+
+public:
+    /// ROM read and pi-rotation, as the first register of the datapath.
+    static void load(int64_t re_in, int64_t im_in, uint32_t counter, uint8_t & R, int64_t & A, int64_t & B) {
+        R = Cordic::rom_cordic.rom[counter];
+        A = (R & 0x01) ? wrap(-re_in, In_W) : wrap(re_in, In_W);
+        B = (R & 0x01) ? wrap(-im_in, In_W) : wrap(im_in, In_W);
+    }
+
+    /// CORDIC stage `u`, as computed by one physical stage.
+    static void step(uint8_t R, unsigned u, int64_t & A, int64_t & B) {
+        if (u > nb_stages) { // Bypassed in the last pass.
+            return;
+        }
+
+        const int64_t shifted_A = A >> (u - 1);
+        const int64_t shifted_B = B >> (u - 1);
+
+        const bool    Ri = ((R >> u) & 0x01) != 0;
+        const int64_t I  = wrap(Ri ? A + shifted_B : A - shifted_B, Out_W);
+        B                = wrap(Ri ? B - shifted_A : B + shifted_A, Out_W);
+        A                = I;
+    }
+
+    /// One pass through the physical stages: CORDIC stages `pass * fold + 1` to `(pass + 1) * fold`.
+    static void iterate(uint8_t R, unsigned pass, int64_t & A, int64_t & B) {
+        for (unsigned p = 0; p < fold; p++) {
+            step(R, pass * fold + p + 1, A, B);
+        }
+    }
+
+    /// Untimed rotation, through the folded schedule.
+    static void cordic(int64_t re_in, int64_t im_in, uint32_t counter, int64_t & re_out, int64_t & im_out) {
+        uint8_t R;
+        load(re_in, im_in, counter, R, re_out, im_out);
+        for (unsigned pass = 0; pass < passes; pass++) {
+            iterate(R, pass, re_out, im_out);
+        }
+    }
+
+    CCordicRotateFolded() : inputs(), outputs(), pre(), loop(), next_channel(0), statistics() {
+        reset();
+    }
+
+    void reset() {
+        for (unsigned c = 0; c < channels; c++) {
+            inputs[c].valid  = false;
+            outputs[c].valid = false;
+        }
+        for (unsigned p = 0; p < fold; p++) {
+            loop[p].valid = false;
+        }
+        pre.valid    = false;
+        next_channel = 0;
+        statistics   = folded_stats {0, 0, 0, 0};
+    }
+
+    /// Write the input register of `channel`, if empty.
+    bool push(unsigned channel, int64_t re_in, int64_t im_in, uint32_t counter) {
+        io_register & in = inputs[channel];
+        if (in.valid) {
+            return false;
+        }
+        in = io_register {true, re_in, im_in, counter};
+        return true;
+    }
+
+    /// Read the output register of `channel`, if full.
+    bool pop(unsigned channel, int64_t & re_out, int64_t & im_out) {
+        io_register & out = outputs[channel];
+        if (!out.valid) {
+            return false;
+        }
+        re_out    = out.re;
+        im_out    = out.im;
+        out.valid = false;
+        return true;
+    }
+
+    /// Advance the datapath by one clock cycle.
+    void tick() {
+        statistics.cycles++;
+
+        const stage_register & last = loop[fold - 1];
+        if (last.valid && last.pass + 1 == passes && outputs[last.channel].valid) {
+            statistics.stall_cycles++; // The whole ring waits.
+        } else {
+            bool busy = false;
+            for (unsigned p = 0; p < fold; p++) {
+                if (loop[p].valid) {
+                    step(loop[p].R, loop[p].pass * fold + p + 1, loop[p].A, loop[p].B);
+                    busy = true;
+                }
+            }
+            statistics.busy_cycles += busy ? 1 : 0;
+
+            stage_register done = last;
+            for (unsigned p = fold - 1; p > 0; p--) {
+                loop[p] = loop[p - 1];
+            }
+            loop[0].valid = false;
+
+            if (done.valid) {
+                if (++done.pass == passes) {
+                    outputs[done.channel] = io_register {true, done.A, done.B, 0};
+                    statistics.samples++;
+                } else {
+                    loop[0] = done; // Next pass, ahead of any new sample.
+                }
+            }
+        }
+
+        if (!loop[0].valid && pre.valid) {
+            loop[0]      = pre;
+            loop[0].pass = 0;
+            pre.valid    = false;
+        }
+
+        if (!pre.valid) {
+            for (unsigned c = 0; c < channels; c++) {
+                const unsigned channel = (next_channel + c) % channels;
+                if (inputs[channel].valid) {
+                    const io_register & in = inputs[channel];
+
+                    pre.valid   = true;
+                    pre.channel = channel;
+                    load(in.re, in.im, in.counter, pre.R, pre.A, pre.B);
+
+                    inputs[channel].valid = false;
+                    next_channel          = (channel + 1) % channels;
+                    break;
+                }
+            }
+        }
+    }
+
+    const folded_stats & stats() const {
+        return statistics;
+    }
+
+    /// Measured throughput, in samples per cycle.
+    double throughput() const {
+        return statistics.cycles > 0 ? double(statistics.samples) / double(statistics.cycles) : 0.;
+    }
+};
+
+#endif // C_CORDIC_ROTATE_FOLDED_HPP
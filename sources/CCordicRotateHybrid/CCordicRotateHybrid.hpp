@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_HYBRID_HPP
+#define C_CORDIC_ROTATE_HYBRID_HPP
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <complex>
+
+#include <ap_fixed.h>
+#include <ap_int.h>
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief Two-level rotator: a coarse ROM CORDIC followed by a small-angle correction.
+ *
+ * The counter has `fine_bits` more bits than the one of the coarse `CCordicRotateConstexpr`:
+ * its upper bits address the coarse ROM, and its `fine_bits` LSBs select a fraction of `rotation / q`.
+ * The remaining angle (that fraction plus the angular error of the coarse CORDIC, stored once per
+ * coarse address) is applied by a first order (`x * (1 + j*d)`) or second order
+ * (`x * (1 - d^2/2 + j*d)`) fixed-point correction.
+ * The angular resolution is therefore `2^fine_bits` times finer for the same coarse ROM.
+ * Outputs share the format of the coarse CORDIC, gain and `scale_cordic` included.
+ */
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider = 2, unsigned Tfine_bits = 4, unsigned Torder = 1>
+class CCordicRotateHybrid {
+    static_assert(TIn_W < 30, "Correction products must fit on 64 bits.");
+    static_assert(Torder == 1 || Torder == 2, "Only first and second order corrections are supported.");
+    static_assert(Tfine_bits < 16, "16 fine bits is the maximum supported.");
+
+public:
+    typedef CCordicRotateConstexpr<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider> coarse_cordic;
+
+    static constexpr unsigned In_W       = TIn_W;
+    static constexpr unsigned In_I       = TIn_I;
+    static constexpr unsigned Out_W      = In_W + 2;
+    static constexpr unsigned Out_I      = In_I + 2;
+    static constexpr unsigned nb_stages  = Tnb_stages;
+    static constexpr unsigned q          = Tq;
+    static constexpr unsigned divider    = Tdivider;
+    static constexpr unsigned fine_bits  = Tfine_bits;
+    static constexpr unsigned order      = Torder;
+    static constexpr unsigned delta_frac = 24;
+
+    static constexpr rcr::generator_type rom_type = coarse_cordic::rom_type;
+
+    static constexpr unsigned kn_i             = coarse_cordic::kn_i;
+    static constexpr unsigned in_scale_factor  = coarse_cordic::in_scale_factor;
+    static constexpr unsigned out_scale_factor = coarse_cordic::out_scale_factor;
+
+    static constexpr double   rotation      = coarse_cordic::rotation;
+    static constexpr unsigned coarse_length = coarse_cordic::max_length;
+    static constexpr unsigned max_length    = coarse_length << fine_bits;
+    static constexpr unsigned addr_length   = coarse_cordic::addr_length + fine_bits;
+
+    /// Angle of one fine step, on `delta_frac` fractional bits.
+    static constexpr int64_t fine_step = int64_t(rotation / double(q) / double(1U << fine_bits) * double(1U << delta_frac) + 0.5);
+
+    struct residual_table {
+        int64_t residual[coarse_length];
+
+        residual_table() {
+            for (unsigned n = 0; n < coarse_length; n++) {
+                const double achieved = rcr::rom_angle(coarse_cordic::rom_cordic.rom[n], nb_stages);
+                const double error    = std::remainder(rotation / double(q) * double(n) - achieved, rcr::two_pi);
+                residual[n]        = int64_t(std::llround(error * double(1U << delta_frac)));
+            }
+        }
+    };
+
+    /// Angular error of the coarse CORDIC at each coarse address, on `delta_frac` fractional bits.
+    static const residual_table & residuals() {
+        static const residual_table table;
+        return table;
+    }
+
+    static constexpr int64_t scale_cordic(int64_t in) {
+        return coarse_cordic::scale_cordic(in);
+    }
+
+    static constexpr double scale_cordic(double in) {
+        return coarse_cordic::scale_cordic(in);
+    }
+
+    static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in) {
+        return coarse_cordic::scale_cordic(in);
+    }
+
+    /// Round-half-up small-angle rotation of the coarse outputs, wrapped on `Out_W` bits.
+    static void correct(int64_t re_in, int64_t im_in, uint64_t counter, int64_t & re_out, int64_t & im_out) {
+        constexpr int64_t  half = int64_t(1) << (delta_frac - 1);
+        constexpr unsigned wrap = 64U - Out_W;
+
+        const uint64_t fine  = counter & ((uint64_t(1) << fine_bits) - 1);
+        const int64_t  delta = residuals().residual[counter >> fine_bits] + int64_t(fine) * fine_step;
+
+        // d^2 / 2, only for the second order.
+        const int64_t cos_term = order == 2 ? (delta * delta) >> (delta_frac + 1) : 0;
+
+        const int64_t re = re_in - ((delta * im_in + cos_term * re_in + half) >> delta_frac);
+        const int64_t im = im_in + ((delta * re_in - cos_term * im_in + half) >> delta_frac);
+
+        re_out = int64_t(uint64_t(re) << wrap) >> wrap;
+        im_out = int64_t(uint64_t(im) << wrap) >> wrap;
+    }
+
+#if !defined(__SYNTHESIS__) && defined(SOFTWARE)
+    static std::complex<int64_t> cordic(std::complex<int64_t> x_in,
+                                        uint64_t              counter) {
+        const std::complex<int64_t> coarse = coarse_cordic::cordic(x_in, counter >> fine_bits);
+
+        int64_t re, im;
+        correct(coarse.real(), coarse.imag(), counter, re, im);
+        return {re, im};
+    }
+
+    static std::complex<double> cordic(std::complex<double> x_in,
+                                       uint64_t             counter) {
+        const std::complex<int64_t> fx_x_in(int64_t(x_in.real() * double(in_scale_factor)),
+                                            int64_t(x_in.imag() * double(in_scale_factor)));
+
+        const std::complex<int64_t> fx_out = cordic(fx_x_in, counter);
+        return {scale_cordic(double(fx_out.real())) / double(out_scale_factor), scale_cordic(double(fx_out.imag())) / double(out_scale_factor)};
+    }
+#endif
+
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                       const ap_uint<addr_length> & counter,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        const ap_uint<coarse_cordic::addr_length> coarse_counter = counter.to_uint64() >> fine_bits;
+
+        ap_int<Out_W> re_coarse, im_coarse;
+        coarse_cordic::cordic(re_in, im_in, coarse_counter, re_coarse, im_coarse);
+
+        int64_t re, im;
+        correct(re_coarse.to_int64(), im_coarse.to_int64(), counter.to_uint64(), re, im);
+        re_out = re;
+        im_out = im;
+    }
+
+    constexpr CCordicRotateHybrid() = default;
+};
+
+#endif // C_CORDIC_ROTATE_HYBRID_HPP
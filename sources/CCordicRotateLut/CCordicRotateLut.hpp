@@ -0,0 +1,216 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_LUT_HPP
+#define C_CORDIC_ROTATE_LUT_HPP
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <complex>
+#include <vector>
+
+#include <ap_fixed.h>
+#include <ap_int.h>
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief Exhaustive output table counterpart of CCordicRotateConstexpr, for narrow inputs.
+ *
+ * With `In_W <= 8`, a ROM address only has `2^(2 * In_W)` possible inputs, so every output of the
+ * `ap_int` datapath is computed once, at first use, and a rotation becomes a single lookup.
+ *
+ * When `Tcompressed` is set, addresses sharing the same stage controls share their table: the
+ * pi-rotation of the ROM word only negates the input on `In_W` bits, which is exactly replayed
+ * before the lookup. Quarter-turn symmetries are not used, since the floor shifts of the datapath
+ * are not odd-symmetric, and the outputs would not be bit-exact anymore.
+ */
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider = 2, bool Tcompressed = true>
+class CCordicRotateLut {
+    static_assert(TIn_W > 0, "Inputs can't be on zero bits.");
+    static_assert(TIn_W <= 8, "Output tables are only practical up to 8-bit inputs.");
+
+    typedef CCordicRotateConstexpr<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider> cordic_t;
+
+public:
+    static constexpr unsigned In_W      = cordic_t::In_W;
+    static constexpr unsigned In_I      = cordic_t::In_I;
+    static constexpr unsigned Out_W     = cordic_t::Out_W;
+    static constexpr unsigned Out_I     = cordic_t::Out_I;
+    static constexpr unsigned nb_stages = cordic_t::nb_stages;
+    static constexpr unsigned q         = cordic_t::q;
+    static constexpr unsigned divider   = cordic_t::divider;
+    static constexpr bool     compressed = Tcompressed;
+
+    static constexpr rcr::generator_type rom_type = cordic_t::rom_type;
+
+    static constexpr unsigned kn_i             = cordic_t::kn_i;
+    static constexpr unsigned in_scale_factor  = cordic_t::in_scale_factor;
+    static constexpr unsigned out_scale_factor = cordic_t::out_scale_factor;
+
+    static constexpr double   rotation    = cordic_t::rotation;
+    static constexpr unsigned max_length  = cordic_t::max_length;
+    static constexpr unsigned addr_length = cordic_t::addr_length;
+
+    static constexpr unsigned in_mask      = (1U << In_W) - 1U;
+    static constexpr unsigned table_length = 1U << (2 * In_W);
+
+    struct output_pair {
+        int16_t re;
+        int16_t im;
+    };
+
+    struct output_table {
+        uint16_t                 index[max_length]; // Table used by each address.
+        bool                     negate[max_length];
+        std::vector<output_pair> values;
+
+        output_table() : index(), negate() {
+            constexpr unsigned nb_words = 1U << nb_stages;
+            int                table_of[nb_words];
+            for (unsigned w = 0; w < nb_words; w++) {
+                table_of[w] = -1;
+            }
+
+            unsigned nb_tables = 0;
+            for (unsigned n = 0; n < max_length; n++) {
+                const uint8_t R = cordic_t::rom_cordic.rom[n];
+                if (compressed) {
+                    const unsigned word = unsigned(R) >> 1;
+                    negate[n]           = (R & 0x01) == 0x01;
+                    if (table_of[word] < 0) {
+                        table_of[word] = int(nb_tables);
+                        fill(n, nb_tables++);
+                    }
+                    index[n] = uint16_t(table_of[word]);
+                } else {
+                    negate[n] = false;
+                    index[n]  = uint16_t(nb_tables);
+                    fill(n, nb_tables++);
+                }
+            }
+        }
+
+    private:
+        // Outputs of the address `n` without its pi-rotation, stored as the table `t`.
+        void fill(unsigned n, unsigned t) {
+            values.resize(size_t(t + 1) * table_length);
+
+            const bool pi_flag = compressed && (cordic_t::rom_cordic.rom[n] & 0x01) == 0x01;
+            for (unsigned re = 0; re < (1U << In_W); re++) {
+                for (unsigned im = 0; im < (1U << In_W); im++) {
+                    ap_int<In_W> re_in = int64_t(re);
+                    ap_int<In_W> im_in = int64_t(im);
+                    if (pi_flag) { // Undone by the datapath.
+                        re_in = ap_int<In_W>(-re_in);
+                        im_in = ap_int<In_W>(-im_in);
+                    }
+
+                    ap_int<Out_W> re_out, im_out;
+                    cordic_t::cordic(re_in, im_in, n, re_out, im_out);
+
+                    output_pair & out = values[size_t(t) * table_length + (re << In_W) + im];
+                    out.re            = int16_t(re_out.to_int());
+                    out.im            = int16_t(im_out.to_int());
+                }
+            }
+        }
+    };
+
+    static const output_table & outputs() {
+        static const output_table table;
+        return table;
+    }
+
+    /// Number of distinct address tables, equal to `max_length` when not compressed.
+    static unsigned nb_tables() {
+        return unsigned(outputs().values.size() / table_length);
+    }
+
+    static size_t table_bytes() {
+        return outputs().values.size() * sizeof(output_pair);
+    }
+
+    static constexpr int64_t scale_cordic(int64_t in) {
+        return in * kn_i / 16U;
+    }
+
+    static constexpr double scale_cordic(double in) {
+        return in * rcr::kn_values[nb_stages - 1];
+    }
+
+    static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in) {
+        const ap_int<Out_W + 4> tmp = in * ap_uint<4>(kn_i);
+        return ap_int<Out_W>(tmp >> 4);
+    }
+
+    /// Only the `In_W` LSBs of the inputs are used, as for an `ap_int<In_W>`.
+    static void lookup(int64_t re_in, int64_t im_in, uint64_t counter, int64_t & re_out, int64_t & im_out) {
+        const output_table & table = outputs();
+
+        uint64_t re = uint64_t(re_in);
+        uint64_t im = uint64_t(im_in);
+        if (table.negate[counter]) {
+            re = uint64_t(0) - re;
+            im = uint64_t(0) - im;
+        }
+
+        const output_pair & out = table.values[size_t(table.index[counter]) * table_length
+                                               + ((re & in_mask) << In_W) + (im & in_mask)];
+        re_out = out.re;
+        im_out = out.im;
+    }
+
+#if !defined(__SYNTHESIS__) && defined(SOFTWARE)
+    static std::complex<int64_t> cordic(std::complex<int64_t> x_in,
+                                        uint64_t              counter) {
+        int64_t re, im;
+        lookup(x_in.real(), x_in.imag(), counter, re, im);
+        return {re, im};
+    }
+
+    static std::complex<double> cordic(std::complex<double> x_in,
+                                       uint64_t             counter) {
+        const std::complex<int64_t> fx_x_in(int64_t(x_in.real() * double(in_scale_factor)),
+                                            int64_t(x_in.imag() * double(in_scale_factor)));
+
+        const std::complex<int64_t> fx_out = cordic(fx_x_in, counter);
+        return {scale_cordic(double(fx_out.real())) / double(out_scale_factor), scale_cordic(double(fx_out.imag())) / double(out_scale_factor)};
+    }
+#endif
+
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                       const ap_uint<addr_length> & counter,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        int64_t re, im;
+        lookup(re_in.to_int64(), im_in.to_int64(), counter.to_uint64(), re, im);
+        re_out = re;
+        im_out = im;
+    }
+
+    constexpr CCordicRotateLut() = default;
+};
+
+#endif // C_CORDIC_ROTATE_LUT_HPP
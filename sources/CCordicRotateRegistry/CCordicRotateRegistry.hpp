@@ -0,0 +1,178 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_REGISTRY_HPP
+#define C_CORDIC_ROTATE_REGISTRY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <ap_int.h>
+
+#include "CCordicProfiler/CCordicProfiler.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+
+/**
+ * @brief Type-erased handle over a compile-time CORDIC rotator.
+ *
+ * Samples are exchanged as `int32_t` holding the raw `ap_int` values, so `Out_W` must not exceed 32 bits.
+ * Dispatch happens once per block: the loops of the implementations are fully specialized.
+ */
+class CCordicRotator {
+public:
+    const unsigned In_W;
+    const unsigned In_I;
+    const unsigned Out_W;
+    const unsigned Out_I;
+    const unsigned nb_stages;
+    const unsigned q;
+    const unsigned divider;
+    const unsigned max_length;
+
+    const rcr::generator_type rom_type; // For the same parameters, cst and ml ROMs differ.
+
+    CCordicRotator(unsigned In_W, unsigned In_I, unsigned Out_W, unsigned Out_I,
+                   unsigned nb_stages, unsigned q, unsigned divider, unsigned max_length,
+                   rcr::generator_type rom_type)
+        : In_W(In_W), In_I(In_I), Out_W(Out_W), Out_I(Out_I),
+          nb_stages(nb_stages), q(q), divider(divider), max_length(max_length), rom_type(rom_type) {}
+
+    virtual ~CCordicRotator() = default;
+
+    /// Rotate `length` samples, sample `i` by `counters[i]` (each lower than `max_length`).
+    virtual void cordic(const int32_t * re_in, const int32_t * im_in, const uint32_t * counters,
+                        int32_t * re_out, int32_t * im_out, size_t length) const = 0;
+
+    /// Rotate `length` samples, sample `i` by `(counter + i) % max_length`.
+    virtual void cordic(const int32_t * re_in, const int32_t * im_in, uint32_t counter,
+                        int32_t * re_out, int32_t * im_out, size_t length) const = 0;
+
+    /// Apply the constant CORDIC gain correction (`scale_cordic`) to a block of outputs, in place.
+    virtual void scale_cordic(int32_t * values, size_t length) const = 0;
+};
+
+template <class Cordic>
+class CCordicRotatorInstance final : public CCordicRotator {
+    static_assert(Cordic::Out_W <= 32, "Registered rotators must fit int32_t outputs.");
+
+    typedef ap_int<Cordic::In_W>         in_t;
+    typedef ap_int<Cordic::Out_W>        out_t;
+    typedef ap_uint<Cordic::addr_length> addr_t;
+
+public:
+    CCordicRotatorInstance()
+        : CCordicRotator(Cordic::In_W, Cordic::In_I, Cordic::Out_W, Cordic::Out_I,
+                         Cordic::nb_stages, Cordic::q, Cordic::divider, Cordic::max_length, Cordic::rom_type) {}
+
+    void cordic(const int32_t * re_in, const int32_t * im_in, const uint32_t * counters,
+                int32_t * re_out, int32_t * im_out, size_t length) const override {
+        CORDIC_PROFILE_SCOPE("CCordicRotator::cordic(counters)", length);
+        for (size_t i = 0; i < length; i++) {
+            out_t re, im;
+            Cordic::cordic(in_t(re_in[i]), in_t(im_in[i]), addr_t(counters[i]), re, im);
+            re_out[i] = re.to_int();
+            im_out[i] = im.to_int();
+        }
+    }
+
+    void cordic(const int32_t * re_in, const int32_t * im_in, uint32_t counter,
+                int32_t * re_out, int32_t * im_out, size_t length) const override {
+        CORDIC_PROFILE_SCOPE("CCordicRotator::cordic(counter)", length);
+        counter %= Cordic::max_length;
+        for (size_t i = 0; i < length; i++) {
+            out_t re, im;
+            Cordic::cordic(in_t(re_in[i]), in_t(im_in[i]), addr_t(counter), re, im);
+            re_out[i] = re.to_int();
+            im_out[i] = im.to_int();
+            counter   = counter + 1 == Cordic::max_length ? 0 : counter + 1;
+        }
+    }
+
+    void scale_cordic(int32_t * values, size_t length) const override {
+        for (size_t i = 0; i < length; i++) {
+            values[i] = Cordic::scale_cordic(out_t(values[i])).to_int();
+        }
+    }
+};
+
+/**
+ * @brief Runtime selection among a chosen set of precompiled rotators.
+ *
+ * `Rotators` may be any class exposing the static interface of `CCordicRotateConstexpr`,
+ * including the generated `CCordicRotateRom` ones. They are looked up by their parameters
+ * and `rom_type`, so a cst and an ml rotator with the same parameters can both be registered.
+ * ``` C++
+ * typedef CCordicRotateRegistry<CCordicRotateConstexpr<16, 4, 6, 64>,
+ *                               CCordicRotateConstexpr<12, 4, 4, 64, 4>> registry;
+ * std::unique_ptr<CCordicRotator> rotator = registry::make_rotator(16, 4, 6, 64, 2);
+ * ```
+ */
+template <class... Rotators>
+class CCordicRotateRegistry {
+    typedef std::unique_ptr<CCordicRotator> (*factory_t)();
+
+    struct entry {
+        unsigned  In_W;
+        unsigned  In_I;
+        unsigned  nb_stages;
+        unsigned  q;
+        unsigned  divider;
+
+        rcr::generator_type rom_type;
+
+        factory_t factory;
+    };
+
+    template <class Cordic>
+    static std::unique_ptr<CCordicRotator> factory() {
+        return std::unique_ptr<CCordicRotator>(new CCordicRotatorInstance<Cordic>());
+    }
+
+    static_assert(sizeof...(Rotators) > 0, "At least one rotator must be registered.");
+
+    static factory_t find(unsigned In_W, unsigned In_I, unsigned nb_stages, unsigned q, unsigned divider,
+                          rcr::generator_type rom_type) {
+        static const entry entries[] = {
+            {Rotators::In_W, Rotators::In_I, Rotators::nb_stages, Rotators::q, Rotators::divider, Rotators::rom_type, &factory<Rotators>}...};
+
+        for (const entry & e : entries) {
+            if (e.In_W == In_W && e.In_I == In_I && e.nb_stages == nb_stages && e.q == q && e.divider == divider
+                && e.rom_type == rom_type) {
+                return e.factory;
+            }
+        }
+        return nullptr;
+    }
+
+public:
+    /// Returns nullptr if the configuration has not been registered.
+    static std::unique_ptr<CCordicRotator> make_rotator(unsigned In_W, unsigned In_I, unsigned nb_stages, unsigned q, unsigned divider = 2,
+                                                        rcr::generator_type rom_type = rcr::generator_type::cst) {
+        const factory_t f = find(In_W, In_I, nb_stages, q, divider, rom_type);
+        return f != nullptr ? f() : nullptr;
+    }
+
+    static bool contains(unsigned In_W, unsigned In_I, unsigned nb_stages, unsigned q, unsigned divider = 2,
+                         rcr::generator_type rom_type = rcr::generator_type::cst) {
+        return find(In_W, In_I, nb_stages, q, divider, rom_type) != nullptr;
+    }
+};
+
+#endif // C_CORDIC_ROTATE_REGISTRY_HPP
@@ -30,7 +30,7 @@ class CCordicRotateRom {
     static_assert(TIn_W > 0, "Inputs can't be on zero bits.");
     static_assert(Tnb_stages < 8, "7 stages of CORDIC is the maximum supported.");
     static_assert(Tnb_stages > 1, "2 stages of CORDIC is the minimum.");
-    static_assert(((divider - 1) & divider) == 0, "divider must be a power of 2.");
+    static_assert(Tq > 0, "q can't be zero.");
 };
 
 #endif // C_CORDIC_ROTATE_ROM_TEMPLATE
\ No newline at end of file
@@ -0,0 +1 @@
+#include "CCordicRotateRom/CCordicRotateRom_ml_16_6_64_2.hpp"
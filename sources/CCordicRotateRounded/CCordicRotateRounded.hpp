@@ -0,0 +1,182 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_ROUNDED_HPP
+#define C_CORDIC_ROTATE_ROUNDED_HPP
+
+#include <cstdint>
+
+#include <complex>
+
+#include <ap_fixed.h>
+#include <ap_int.h>
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+enum class rounding_mode : uint8_t {
+    truncate   = 0, ///< Floor, as `A >> (u - 1)`.
+    half_up    = 1, ///< Nearest, ties toward +infinity.
+    convergent = 2  ///< Nearest, ties to even.
+};
+
+namespace rom_cordic_rotate {
+
+/// Arithmetic right shift of `value` by `shift` bits, rounded according to `mode`.
+template <rounding_mode mode>
+constexpr int64_t round_shift(int64_t value, unsigned shift) {
+    if (shift == 0 || mode == rounding_mode::truncate) {
+        return value >> shift;
+    }
+
+    const int64_t half      = int64_t(1) << (shift - 1);
+    const int64_t remainder = value & ((int64_t(1) << shift) - 1);
+    const int64_t floor     = value >> shift;
+
+    if (mode == rounding_mode::half_up) {
+        return floor + (remainder >= half ? 1 : 0);
+    }
+    return floor + ((remainder > half || (remainder == half && (floor & 1) == 1)) ? 1 : 0);
+}
+
+} // namespace rom_cordic_rotate
+
+/**
+ * @brief CCordicRotateConstexpr with a rounding policy, internal guard bits and a chosen output width.
+ *
+ * Inputs are extended by `Tguard_bits` fractional bits, every stage shift is rounded according to
+ * `Trounding` on `Int_W = In_W + 2 + guard_bits` bits, and the result is rounded back, with the
+ * same mode, to `TOut_W` bits keeping the `Out_I = In_I + 2` integer bits. Intermediate values
+ * wrap on `Int_W` bits and outputs on `Out_W` bits, as the `ap_int` datapath does.
+ *
+ * With the default policies (truncation, no guard bits, `Out_W = In_W + 2`), outputs are bit-exact
+ * with CCordicRotateConstexpr. Rounding removes the bias of the truncations, so that the same SNR is
+ * reached with a narrower datapath.
+ */
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider = 2,
+          rounding_mode Trounding = rounding_mode::truncate, unsigned Tguard_bits = 0, unsigned TOut_W = TIn_W + 2>
+class CCordicRotateRounded {
+    static_assert(TIn_W + 2 + Tguard_bits <= 48, "Internal values must fit on 64 bits with their guard bits.");
+    static_assert(TOut_W >= TIn_I + 2, "Outputs must keep the integer bits of the CORDIC.");
+    static_assert(TOut_W <= 64, "Outputs must fit on 64 bits.");
+
+public:
+    /// Datapath of the default policies, whose ROM is shared.
+    typedef CCordicRotateConstexpr<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider> cordic_t;
+
+    static constexpr unsigned In_W       = cordic_t::In_W;
+    static constexpr unsigned In_I       = cordic_t::In_I;
+    static constexpr unsigned Out_W      = TOut_W;
+    static constexpr unsigned Out_I      = In_I + 2;
+    static constexpr unsigned nb_stages  = cordic_t::nb_stages;
+    static constexpr unsigned q          = cordic_t::q;
+    static constexpr unsigned divider    = cordic_t::divider;
+    static constexpr unsigned guard_bits = Tguard_bits;
+    static constexpr unsigned Int_W      = In_W + 2 + guard_bits;
+
+    static constexpr rcr::generator_type rom_type = cordic_t::rom_type;
+
+    static constexpr rounding_mode rounding = Trounding;
+
+    static constexpr unsigned kn_i             = cordic_t::kn_i;
+    static constexpr unsigned in_scale_factor  = cordic_t::in_scale_factor;
+    static constexpr unsigned out_scale_factor = unsigned(1U << (Out_W - Out_I));
+
+    static constexpr double   rotation    = cordic_t::rotation;
+    static constexpr unsigned max_length  = cordic_t::max_length;
+    static constexpr unsigned addr_length = cordic_t::addr_length;
+
+    static constexpr int64_t wrap(int64_t value, unsigned width) {
+        return int64_t(uint64_t(value) << (64 - width)) >> (64 - width);
+    }
+
+    static void rotate(int64_t re_in, int64_t im_in, uint64_t counter, int64_t & re_out, int64_t & im_out) {
+        const uint8_t R = cordic_t::rom_cordic.rom[counter];
+
+        // The pi-rotation wraps on In_W bits, as the ap_int<In_W> negation does.
+        int64_t A = (R & 0x01) == 0x01 ? wrap(-re_in, In_W) : wrap(re_in, In_W);
+        int64_t B = (R & 0x01) == 0x01 ? wrap(-im_in, In_W) : wrap(im_in, In_W);
+        A         = A * (int64_t(1) << guard_bits);
+        B         = B * (int64_t(1) << guard_bits);
+
+        for (unsigned u = 1; u < nb_stages + 1; u++) {
+            const bool Ri = ((R >> u) & 0x01) == 0x01;
+
+            const int64_t shifted_A = rcr::round_shift<rounding>(A, u - 1);
+            const int64_t shifted_B = rcr::round_shift<rounding>(B, u - 1);
+
+            const int64_t I = Ri ? A + shifted_B : A - shifted_B;
+            B               = wrap(Ri ? B - shifted_A : B + shifted_A, Int_W);
+            A               = wrap(I, Int_W);
+        }
+
+        // Back to Out_W bits: rounded when narrower, padded with zeros when wider.
+        constexpr unsigned drop = Int_W > Out_W ? Int_W - Out_W : 0;
+        constexpr unsigned grow = Out_W > Int_W ? Out_W - Int_W : 0;
+
+        re_out = wrap(rcr::round_shift<rounding>(A, drop) * (int64_t(1) << grow), Out_W);
+        im_out = wrap(rcr::round_shift<rounding>(B, drop) * (int64_t(1) << grow), Out_W);
+    }
+
+    static constexpr int64_t scale_cordic(int64_t in) {
+        return in * kn_i / 16U;
+    }
+
+    static constexpr double scale_cordic(double in) {
+        return in * rcr::kn_values[nb_stages - 1];
+    }
+
+    static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in) {
+        const ap_int<Out_W + 4> tmp = in * ap_uint<4>(kn_i);
+        return ap_int<Out_W>(tmp >> 4);
+    }
+
+#if !defined(__SYNTHESIS__) && defined(SOFTWARE)
+    static std::complex<int64_t> cordic(std::complex<int64_t> x_in,
+                                        uint64_t              counter) {
+        int64_t re, im;
+        rotate(x_in.real(), x_in.imag(), counter, re, im);
+        return {re, im};
+    }
+
+    static std::complex<double> cordic(std::complex<double> x_in,
+                                       uint64_t             counter) {
+        const std::complex<int64_t> fx_x_in(int64_t(x_in.real() * double(in_scale_factor)),
+                                            int64_t(x_in.imag() * double(in_scale_factor)));
+
+        const std::complex<int64_t> fx_out = cordic(fx_x_in, counter);
+        return {scale_cordic(double(fx_out.real())) / double(out_scale_factor), scale_cordic(double(fx_out.imag())) / double(out_scale_factor)};
+    }
+#endif
+
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                       const ap_uint<addr_length> & counter,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        int64_t re, im;
+        rotate(re_in.to_int64(), im_in.to_int64(), counter.to_uint64(), re, im);
+        re_out = re;
+        im_out = im;
+    }
+
+    constexpr CCordicRotateRounded() = default;
+};
+
+#endif // C_CORDIC_ROTATE_ROUNDED_HPP
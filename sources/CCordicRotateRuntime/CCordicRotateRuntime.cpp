@@ -0,0 +1,35 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateRuntime.hpp"
+
+CCordicRotateRuntime::CCordicRotateRuntime(unsigned In_W, unsigned In_I, unsigned nb_stages, unsigned q, unsigned divider, const uint8_t * rom)
+    : In_W(In_W),
+      In_I(In_I),
+      Out_W(In_W + 2),
+      Out_I(In_I + 2),
+      nb_stages(nb_stages),
+      q(q),
+      divider(divider),
+      rotation(rcr::rom_rotation(divider)),
+      max_length(unsigned(rcr::rom_length(q, divider))),
+      kn_i(uint64_t(rcr::kn_values[nb_stages - 1] * double(1U << 4))), // 4 bits are enough
+      in_scale_factor(uint64_t(1U) << (In_W - In_I)),
+      out_scale_factor(uint64_t(1U) << (Out_W - Out_I)),
+      rom(rom) {}
@@ -0,0 +1,98 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_RUNTIME_HPP
+#define C_CORDIC_ROTATE_RUNTIME_HPP
+
+#include <cstdint>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief ROM-based CORDIC rotation whose configuration is only known at runtime.
+ *
+ * The datapath is modeled on 64-bit integers, with the same wrap-around behaviour as
+ * the `ap_int` overload of `CCordicRotateConstexpr::cordic`, to which it is bit-exact
+ * as long as `Out_W` fits in 63 bits.
+ * The ROM is not owned: `rom` must outlive the rotator and hold `max_length` words.
+ */
+class CCordicRotateRuntime {
+public:
+    const unsigned In_W;
+    const unsigned In_I;
+    const unsigned Out_W;
+    const unsigned Out_I;
+    const unsigned nb_stages;
+    const unsigned q;
+    const unsigned divider;
+
+    const double   rotation;
+    const unsigned max_length;
+
+    const uint64_t kn_i;
+    const uint64_t in_scale_factor;
+    const uint64_t out_scale_factor;
+
+    const uint8_t * const rom;
+
+    CCordicRotateRuntime(unsigned In_W, unsigned In_I, unsigned nb_stages, unsigned q, unsigned divider, const uint8_t * rom);
+
+    /// Sign-extend the `width` LSBs of `value`, as an `ap_int<width>` assignment would.
+    static inline int64_t wrap(int64_t value, unsigned width) {
+        const unsigned shift = 64U - width;
+        return int64_t(uint64_t(value) << shift) >> shift;
+    }
+
+    int64_t scale_cordic(int64_t in) const {
+        return wrap((in * int64_t(kn_i)) >> 4, Out_W);
+    }
+
+    double scale_cordic(double in) const {
+        return in * rcr::kn_values[nb_stages - 1];
+    }
+
+    /// `counter` must be lower than `max_length`.
+    void cordic(int64_t re_in, int64_t im_in, uint64_t counter, int64_t & re_out, int64_t & im_out) const {
+        const uint8_t R = rom[counter];
+
+        int64_t A = (R & 0x01) ? wrap(-re_in, In_W) : re_in;
+        int64_t B = (R & 0x01) ? wrap(-im_in, In_W) : im_in;
+
+        for (uint8_t u = 1; u < nb_stages + 1; u++) {
+            const bool Ri = ((R >> u) & 0x01) != 0;
+
+            const int64_t shifted_A = A >> (u - 1);
+            const int64_t shifted_B = B >> (u - 1);
+
+            const int64_t arc_step_A = Ri ? wrap(-shifted_A, Out_W) : shifted_A;
+            const int64_t arc_step_B = Ri ? shifted_B : wrap(-shifted_B, Out_W);
+
+            const int64_t I = wrap(A + arc_step_B, Out_W);
+            B               = wrap(B + arc_step_A, Out_W);
+            A               = I;
+        }
+
+        re_out = A;
+        im_out = B;
+    }
+};
+
+#endif // C_CORDIC_ROTATE_RUNTIME_HPP
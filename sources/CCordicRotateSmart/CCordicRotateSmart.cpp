@@ -19,6 +19,8 @@
 
 #include "CCordicRotateSmart.hpp"
 
+#include "CCordicProfiler/CCordicProfiler.hpp"
+
 #define uint2int(sz, in) ((in & (1U << sz)) == (1U << sz)   \
                               ? static_cast<short>(~in + 1) \
                               : static_cast<short>(in))
@@ -30,6 +32,7 @@ void CCordicRotateSmart<8, 14, 4, 17, 5, 19, 7, 12>::process(
     const ap_fixed<17, 5> & fx_im_in,
     ap_fixed<19, 7> &       fx_re_out,
     ap_fixed<19, 7> &       fx_im_out) {
+    CORDIC_PROFILE_SCOPE("CCordicRotateSmart::process", 1);
 
     // constexpr uint64_t sign_mask_14 = 0x2000;  // 0bxxx xx10 0000 0000 0000
     // constexpr uint64_t sign_mask_17 = 0x10000; // 0bxx1 0000 0000 0000 0000
@@ -169,3 +172,111 @@ void CCordicRotateSmart<8, 14, 4, 17, 5, 19, 7, 12>::process(
     fx_re_out.V = *reinterpret_cast<const uint64_t *>(&i_xn);
     fx_im_out.V = *reinterpret_cast<const uint64_t *>(&i_b_yn);
 }
+
+namespace {
+
+// Sign extension of the `width` LSBs, the same as the `(x & 2^(width - 1)) ? x | -2^(width - 1) : x & (2^(width - 1) - 1)` of `process`.
+inline int32_t sext(int32_t x, unsigned width) {
+    const int32_t sign = int32_t(1) << (width - 1);
+    return ((x & ((sign << 1) - 1)) ^ sign) - sign;
+}
+
+// The `uint2int` of `process`, including its `short` truncation.
+inline int32_t bits_to_int(uint32_t bits, unsigned sz) {
+    return ((bits >> sz) & 1U) != 0 ? int32_t(short(~bits + 1U)) : int32_t(short(bits));
+}
+
+constexpr size_t smart_block = 64;
+
+} // namespace
+
+template <>
+void CCordicRotateSmart<8, 14, 4, 17, 5, 19, 7, 12>::process_bits(
+    const uint16_t * angle_bits,
+    const uint32_t * re_in_bits,
+    const uint32_t * im_in_bits,
+    int32_t *        re_out,
+    int32_t *        im_out,
+    size_t           nb_samples) {
+    CORDIC_PROFILE_SCOPE("CCordicRotateSmart::process_bits", nb_samples);
+
+    int32_t z[smart_block], xn[smart_block], yn[smart_block], xs[smart_block], ys[smart_block];
+    bool    negate[smart_block];
+
+    for (size_t start = 0; start < nb_samples; start += smart_block) {
+        const size_t length = nb_samples - start < smart_block ? nb_samples - start : smart_block;
+
+        // Quadrant folding: selects mirroring the branches of `process`.
+        for (size_t n = 0; n < length; n++) {
+            const int32_t angle = bits_to_int(angle_bits[start + n], 14);
+            const int32_t dir   = int32_t(angle > 1608) - int32_t(angle < -1608);
+
+            const int32_t half_turn = sext(angle - dir * 3217, 14);
+            const int32_t full_turn = sext(angle - dir * 6434, 14);
+            const bool    keep_half = dir > 0 ? half_turn <= 1608 : half_turn >= -1608;
+
+            const int32_t folded = dir == 0 ? angle : (keep_half ? half_turn : full_turn);
+
+            z[n]      = sext(folded * 4, 14);
+            negate[n] = dir != 0 && keep_half;
+
+            xn[n] = bits_to_int(re_in_bits[start + n], 17);
+            yn[n] = bits_to_int(im_in_bits[start + n], 17);
+            xs[n] = xn[n];
+            ys[n] = yn[n];
+        }
+
+        for (unsigned idx = 0; idx < 8; idx++) {
+            const int32_t atan = int32_t(atanLUT.table[idx]);
+            for (size_t n = 0; n < length; n++) {
+                const int32_t up = -int32_t(z[n] >= 0); // -1 when rotating clockwise
+
+                z[n]  = sext(z[n] + ((atan ^ up) - up), 14);
+                xn[n] = sext(xn[n] + ((ys[n] ^ up) - up), 19);
+                yn[n] = sext(yn[n] + ((xs[n] ^ ~up) - ~up), 19);
+                xs[n] = sext(xn[n] >> (idx + 1), 19);
+                ys[n] = sext(yn[n] >> (idx + 1), 19);
+            }
+        }
+
+        for (size_t n = 0; n < length; n++) {
+            const int64_t re = negate[n] ? sext(-xn[n], 19) : xn[n];
+            const int64_t im = negate[n] ? sext(-yn[n], 19) : yn[n];
+
+            re_out[start + n] = sext(int32_t((re * 39797L) >> 16), 19);
+            im_out[start + n] = sext(int32_t((im * 39797L) >> 16), 19);
+        }
+    }
+}
+
+template <>
+void CCordicRotateSmart<8, 14, 4, 17, 5, 19, 7, 12>::process(
+    const ap_fixed<14, 4> * fx_angles,
+    const ap_fixed<17, 5> * fx_re_in,
+    const ap_fixed<17, 5> * fx_im_in,
+    ap_fixed<19, 7> *       fx_re_out,
+    ap_fixed<19, 7> *       fx_im_out,
+    size_t                  nb_samples) {
+    CORDIC_PROFILE_SCOPE("CCordicRotateSmart::process(batch)", nb_samples);
+
+    uint16_t angle_bits[smart_block];
+    uint32_t re_bits[smart_block], im_bits[smart_block];
+    int32_t  re[smart_block], im[smart_block];
+
+    for (size_t start = 0; start < nb_samples; start += smart_block) {
+        const size_t length = nb_samples - start < smart_block ? nb_samples - start : smart_block;
+
+        for (size_t n = 0; n < length; n++) {
+            angle_bits[n] = uint16_t(fx_angles[start + n].bits_to_uint64());
+            re_bits[n]    = uint32_t(fx_re_in[start + n].bits_to_uint64());
+            im_bits[n]    = uint32_t(fx_im_in[start + n].bits_to_uint64());
+        }
+
+        process_bits(angle_bits, re_bits, im_bits, re, im, length);
+
+        for (size_t n = 0; n < length; n++) {
+            fx_re_out[start + n].V = uint64_t(int64_t(re[n]));
+            fx_im_out[start + n].V = uint64_t(int64_t(im[n]));
+        }
+    }
+}
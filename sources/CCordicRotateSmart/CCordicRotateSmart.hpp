@@ -22,6 +22,7 @@
 
 #include <climits>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 
@@ -74,6 +75,30 @@ public:
         ap_fixed<OUT_W, OUT_I> &     fx_re_out,
         ap_fixed<OUT_W, OUT_I> &     fx_im_out);
 
+    /**
+     * @brief Batch counterpart of `process`, with one angle per sample, bit-exact with it.
+     *
+     * Inputs are the bits returned by `bits_to_uint64()`, truncated as `process` does, and outputs
+     * are the sign-extended raw values of the `ap_fixed<OUT_W, OUT_I>` results. The quadrant folding
+     * and the stage directions are computed as selects instead of branches, and samples are
+     * processed stage after stage by blocks, so that the compiler can vectorize the loops.
+     */
+    static void process_bits(
+        const uint16_t * angle_bits,
+        const uint32_t * re_in_bits,
+        const uint32_t * im_in_bits,
+        int32_t *        re_out,
+        int32_t *        im_out,
+        size_t           nb_samples);
+
+    static void process(
+        const ap_fixed<TH_W, TH_I> * fx_angles,
+        const ap_fixed<IN_W, IN_I> * fx_re_in,
+        const ap_fixed<IN_W, IN_I> * fx_im_in,
+        ap_fixed<OUT_W, OUT_I> *     fx_re_out,
+        ap_fixed<OUT_W, OUT_I> *     fx_im_out,
+        size_t                       nb_samples);
+
     CCordicRotateSmart() {}
     virtual ~CCordicRotateSmart() {};
 };
@@ -0,0 +1,175 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_SWAR_HPP
+#define C_CORDIC_ROTATE_SWAR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <complex>
+
+#include <ap_fixed.h>
+#include <ap_int.h>
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief SWAR counterpart of CCordicRotateConstexpr: both components of a sample in one 64-bit word.
+ *
+ * The real part lives in the upper 32-bit lane and the imaginary part in the lower one, each on
+ * `Out_W` bits in offset binary (`v + 2^(Out_W - 1)`). In this encoding, the floor shift of a
+ * component is a logical shift of its lane, and a whole stage is a shift, a lane swap, a
+ * conditional complement, two additions and a mask: the truncations and the `Out_W` wrap-around
+ * of the `ap_int` datapath are reproduced exactly, for a fraction of its scalar instructions.
+ */
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider = 2>
+class CCordicRotateSwar {
+    static_assert(TIn_W > 0, "Inputs can't be on zero bits.");
+    static_assert(TIn_W <= 16, "Both components must fit a 32-bit lane with their guard bits.");
+    static_assert(Tnb_stages <= TIn_W + 2, "Shifted lanes must keep an integer offset.");
+    static_assert(TIn_W + 2 + Tnb_stages <= 33, "Shifted bits of the upper lane must stay above the lower one.");
+
+    typedef CCordicRotateConstexpr<TIn_W, TIn_I, Tnb_stages, Tq, Tdivider> cordic_t;
+
+public:
+    static constexpr unsigned In_W      = cordic_t::In_W;
+    static constexpr unsigned In_I      = cordic_t::In_I;
+    static constexpr unsigned Out_W     = cordic_t::Out_W;
+    static constexpr unsigned Out_I     = cordic_t::Out_I;
+    static constexpr unsigned nb_stages = cordic_t::nb_stages;
+    static constexpr unsigned q         = cordic_t::q;
+    static constexpr unsigned divider   = cordic_t::divider;
+
+    static constexpr rcr::generator_type rom_type = cordic_t::rom_type;
+
+    static constexpr unsigned kn_i             = cordic_t::kn_i;
+    static constexpr unsigned in_scale_factor  = cordic_t::in_scale_factor;
+    static constexpr unsigned out_scale_factor = cordic_t::out_scale_factor;
+
+    static constexpr double   rotation    = cordic_t::rotation;
+    static constexpr unsigned max_length  = cordic_t::max_length;
+    static constexpr unsigned addr_length = cordic_t::addr_length;
+
+    static constexpr uint64_t lane_mask = (uint64_t(1) << Out_W) - 1U;
+    static constexpr uint64_t word_mask = (lane_mask << 32) | lane_mask;
+    static constexpr uint64_t offset    = uint64_t(1) << (Out_W - 1);
+
+    static constexpr uint64_t pack(int64_t re, int64_t im) {
+        return (((uint64_t(re) + offset) & lane_mask) << 32) | ((uint64_t(im) + offset) & lane_mask);
+    }
+
+    static constexpr int64_t unpack_lane(uint64_t lane) {
+        return int64_t(((lane & lane_mask) ^ offset) << (64 - Out_W)) >> (64 - Out_W);
+    }
+
+    /// Run the stages on a packed word, with the stage controls `R` of a ROM word (pi flag excluded).
+    static uint64_t stages(uint64_t x, unsigned R) {
+        for (unsigned u = 1; u < nb_stages + 1; u++) {
+            const bool     Ri       = ((R >> u) & 0x01) == 0x01;
+            const uint64_t offset_k = offset >> (u - 1);
+
+            // Adding lane: x + y - offset_k. Subtracting lane: x + ~y + offset_k + 1, i.e. x - y + offset_k.
+            const uint64_t add_k = (lane_mask + 1U) - offset_k;
+            const uint64_t sub_k = offset_k + 1U;
+
+            // Ri: I = A + (B >> (u - 1)), B = B - (A >> (u - 1)), A being the upper lane.
+            const uint64_t complement = Ri ? lane_mask : (lane_mask << 32);
+            const uint64_t constants  = Ri ? ((add_k << 32) | sub_k) : ((sub_k << 32) | add_k);
+
+            const uint64_t shifted = (x >> (u - 1)) & word_mask;
+            const uint64_t swapped = (shifted << 32) | (shifted >> 32);
+
+            x = (x + (swapped ^ complement) + constants) & word_mask;
+        }
+        return x;
+    }
+
+    static void rotate(int64_t re_in, int64_t im_in, uint64_t counter, int64_t & re_out, int64_t & im_out) {
+        const uint8_t R = cordic_t::rom_cordic.rom[counter];
+
+        // The pi-rotation wraps on In_W bits, as the ap_int<In_W> negation does.
+        const uint64_t sign = (R & 0x01) == 0x01 ? ~uint64_t(0) : 0;
+        const int64_t  re   = int64_t(((uint64_t(re_in) ^ sign) - sign) << (64 - In_W)) >> (64 - In_W);
+        const int64_t  im   = int64_t(((uint64_t(im_in) ^ sign) - sign) << (64 - In_W)) >> (64 - In_W);
+
+        const uint64_t x = stages(pack(re, im), R);
+
+        re_out = unpack_lane(x >> 32);
+        im_out = unpack_lane(x);
+    }
+
+    static constexpr int64_t scale_cordic(int64_t in) {
+        return in * kn_i / 16U;
+    }
+
+    static constexpr double scale_cordic(double in) {
+        return in * rcr::kn_values[nb_stages - 1];
+    }
+
+    static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in) {
+        const ap_int<Out_W + 4> tmp = in * ap_uint<4>(kn_i);
+        return ap_int<Out_W>(tmp >> 4);
+    }
+
+#if !defined(__SYNTHESIS__) && defined(SOFTWARE)
+    static std::complex<int64_t> cordic(std::complex<int64_t> x_in,
+                                        uint64_t              counter) {
+        int64_t re, im;
+        rotate(x_in.real(), x_in.imag(), counter, re, im);
+        return {re, im};
+    }
+
+    static std::complex<double> cordic(std::complex<double> x_in,
+                                       uint64_t             counter) {
+        const std::complex<int64_t> fx_x_in(int64_t(x_in.real() * double(in_scale_factor)),
+                                            int64_t(x_in.imag() * double(in_scale_factor)));
+
+        const std::complex<int64_t> fx_out = cordic(fx_x_in, counter);
+        return {scale_cordic(double(fx_out.real())) / double(out_scale_factor), scale_cordic(double(fx_out.imag())) / double(out_scale_factor)};
+    }
+#endif
+
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                       const ap_uint<addr_length> & counter,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        int64_t re, im;
+        rotate(re_in.to_int64(), im_in.to_int64(), counter.to_uint64(), re, im);
+        re_out = re;
+        im_out = im;
+    }
+
+    /// Block rotation of C-types samples, `In_W` LSBs of the inputs being used.
+    static void cordic(const int32_t * re_in, const int32_t * im_in, const uint32_t * counters,
+                       int32_t * re_out, int32_t * im_out, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            int64_t re, im;
+            rotate(re_in[i], im_in[i], counters[i], re, im);
+            re_out[i] = int32_t(re);
+            im_out[i] = int32_t(im);
+        }
+    }
+
+    constexpr CCordicRotateSwar() = default;
+};
+
+#endif // C_CORDIC_ROTATE_SWAR_HPP
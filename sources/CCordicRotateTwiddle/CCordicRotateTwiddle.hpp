@@ -0,0 +1,149 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_ROTATE_TWIDDLE_HPP
+#define C_CORDIC_ROTATE_TWIDDLE_HPP
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+#include <complex>
+
+#include <ap_fixed.h>
+#include <ap_int.h>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief Table-and-multiply counterpart of CCordicRotateConstexpr, meant for general-purpose CPUs.
+ *
+ * Each of the `max_length` addresses stores `exp(j * rotation / q * n)`, multiplied by the gain of
+ * a `nb_stages` CORDIC, on `tw_frac` fractional bits. Outputs are rounded to the very same format
+ * as the CORDIC ones (including its gain), so both engines are interchangeable, `scale_cordic` included.
+ */
+template <unsigned TIn_W, unsigned TIn_I, unsigned Tnb_stages, unsigned Tq, unsigned Tdivider = 2>
+class CCordicRotateTwiddle {
+    static_assert(TIn_W > 0, "Inputs can't be on zero bits.");
+    static_assert(TIn_W < 30, "Twiddle products must fit on 64 bits.");
+    static_assert(Tnb_stages < 8, "7 stages of CORDIC is the maximum supported.");
+    static_assert(Tnb_stages > 1, "2 stages of CORDIC is the minimum.");
+    static_assert(Tq > 0, "q can't be zero.");
+
+public:
+    static constexpr unsigned In_W      = TIn_W;
+    static constexpr unsigned In_I      = TIn_I;
+    static constexpr unsigned Out_W     = In_W + 2;
+    static constexpr unsigned Out_I     = In_I + 2;
+    static constexpr unsigned nb_stages = Tnb_stages;
+    static constexpr unsigned q         = Tq;
+    static constexpr unsigned divider   = Tdivider;
+    static constexpr unsigned tw_frac   = In_W + 1;
+
+    /// No control words: the twiddles sit on the address grid of the cst ROM.
+    static constexpr rcr::generator_type rom_type = rcr::generator_type::cst;
+
+    static constexpr unsigned kn_i             = unsigned(rcr::kn_values[nb_stages - 1] * double(1U << 4)); // 4 bits are enough
+    static constexpr unsigned in_scale_factor  = unsigned(1U << (In_W - In_I));
+    static constexpr unsigned out_scale_factor = unsigned(1U << (Out_W - Out_I));
+
+    static constexpr double   rotation    = rcr::rom_rotation(divider);
+    static constexpr unsigned max_length  = unsigned(rcr::rom_length(q, divider));
+    static constexpr unsigned addr_length = rcr::needed_bits<max_length - 1>();
+
+    struct twiddle_table {
+        int64_t re[max_length];
+        int64_t im[max_length];
+
+        twiddle_table() {
+            const double gain = double(1ULL << tw_frac) / rcr::kn_values[nb_stages - 1];
+            for (unsigned n = 0; n < max_length; n++) {
+                const double angle = rotation / double(q) * double(n);
+                re[n]              = int64_t(std::llround(std::cos(angle) * gain));
+                im[n]              = int64_t(std::llround(std::sin(angle) * gain));
+            }
+        }
+    };
+
+    static const twiddle_table & twiddles() {
+        static const twiddle_table table;
+        return table;
+    }
+
+    static constexpr int64_t scale_cordic(int64_t in) {
+        return in * kn_i / 16U;
+    }
+
+    static constexpr double scale_cordic(double in) {
+        return in * rcr::kn_values[nb_stages - 1];
+    }
+
+    static ap_int<Out_W> scale_cordic(const ap_int<Out_W> & in) {
+        const ap_int<Out_W + 4> tmp = in * ap_uint<4>(kn_i);
+        return ap_int<Out_W>(tmp >> 4);
+    }
+
+    /// Round-half-up complex product, wrapped on `Out_W` bits like an `ap_int<Out_W>`.
+    static void multiply(int64_t re_in, int64_t im_in, uint64_t counter, int64_t & re_out, int64_t & im_out) {
+        constexpr int64_t half  = int64_t(1) << (tw_frac - 1);
+        constexpr unsigned wrap = 64U - Out_W;
+
+        const twiddle_table & tw = twiddles();
+
+        const int64_t re = (re_in * tw.re[counter] - im_in * tw.im[counter] + half) >> tw_frac;
+        const int64_t im = (re_in * tw.im[counter] + im_in * tw.re[counter] + half) >> tw_frac;
+
+        re_out = int64_t(uint64_t(re) << wrap) >> wrap;
+        im_out = int64_t(uint64_t(im) << wrap) >> wrap;
+    }
+
+#if !defined(__SYNTHESIS__) && defined(SOFTWARE)
+    static std::complex<int64_t> cordic(std::complex<int64_t> x_in,
+                                        uint64_t              counter) {
+        int64_t re, im;
+        multiply(x_in.real(), x_in.imag(), counter, re, im);
+        return {re, im};
+    }
+
+    static std::complex<double> cordic(std::complex<double> x_in,
+                                       uint64_t             counter) {
+        const std::complex<int64_t> fx_x_in(int64_t(x_in.real() * double(in_scale_factor)),
+                                            int64_t(x_in.imag() * double(in_scale_factor)));
+
+        const std::complex<int64_t> fx_out = cordic(fx_x_in, counter);
+        return {scale_cordic(double(fx_out.real())) / double(out_scale_factor), scale_cordic(double(fx_out.imag())) / double(out_scale_factor)};
+    }
+#endif
+
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in,
+                       const ap_uint<addr_length> & counter,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        int64_t re, im;
+        multiply(re_in.to_int64(), im_in.to_int64(), counter.to_uint64(), re, im);
+        re_out = re;
+        im_out = im;
+    }
+
+    constexpr CCordicRotateTwiddle() = default;
+};
+
+#endif // C_CORDIC_ROTATE_TWIDDLE_HPP
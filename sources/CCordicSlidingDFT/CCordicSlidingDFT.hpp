@@ -0,0 +1,177 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_SLIDING_DFT_HPP
+#define C_CORDIC_SLIDING_DFT_HPP
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+
+#include "RomRotateCommon/definitions.hpp"
+
+namespace rcr = rom_cordic_rotate;
+
+/**
+ * @brief `K` bins of a sliding `N`-point DFT, computed by a ROM-based CORDIC.
+ *
+ * Each bin accumulates `sum x(m) * exp(-2j * pi * k * m / N)` over the last `N` samples, whose
+ * phase is thus referenced to the first pushed sample (multiply by `exp(2j * pi * k * (n - N + 1) / N)`
+ * to get the usual window-relative DFT).
+ * Since the counter of bin `k` steps by `k * max_length / N`, the sample leaving the window is
+ * rotated by the very same ROM word as when it entered it: it is rotated again and subtracted,
+ * so the integer accumulators never drift, whatever the CORDIC rounding.
+ * Accumulators grow by `log2(N)` bits over the `Out_W` bits of the CORDIC outputs.
+ *
+ * `Cordic` must be a `CCordicRotateConstexpr`: its ROM is read directly, and the rotations,
+ * performed for every bin at once (so the compiler can vectorize them), are bit-exact with
+ * its `ap_int` `cordic` overload.
+ */
+template <class Cordic, unsigned N, unsigned K>
+class CCordicSlidingDFT {
+    static_assert(rcr::is_pow_2<N>(), "Window length must be a power of 2.");
+    static_assert(K > 0, "At least one bin must be tracked.");
+    static_assert(Cordic::max_length % N == 0, "The ROM must hold every N-th root of unity.");
+    static_assert(Cordic::Out_W + rcr::needed_bits<N - 1>() < 64, "Accumulators must fit on 64 bits.");
+
+public:
+    static constexpr unsigned length     = N;
+    static constexpr unsigned nb_bins    = K;
+    static constexpr unsigned In_W       = Cordic::In_W;
+    static constexpr unsigned Out_W      = Cordic::Out_W;
+    static constexpr unsigned acc_W      = Out_W + rcr::needed_bits<N - 1>();
+    static constexpr unsigned nb_stages  = Cordic::nb_stages;
+    static constexpr unsigned max_length = Cordic::max_length;
+
+private:
+    unsigned bins[K];
+    uint32_t counters[K];
+    uint32_t steps[K];
+
+    int64_t acc_re[K];
+    int64_t acc_im[K];
+
+    int64_t  window_re[N];
+    int64_t  window_im[N];
+    unsigned head;
+
+    static inline int64_t wrap(int64_t value, unsigned width) {
+        const unsigned shift = 64U - width;
+        return int64_t(uint64_t(value) << shift) >> shift;
+    }
+
+    /// Rotate `(re, im)` by the ROM word of each bin, stage after stage across every bin.
+    static void rotate(int64_t re, int64_t im, const uint8_t (&R)[K], int64_t (&A)[K], int64_t (&B)[K]) {
+        const int64_t neg_re = wrap(-re, In_W);
+        const int64_t neg_im = wrap(-im, In_W);
+
+        for (unsigned k = 0; k < K; k++) {
+            A[k] = (R[k] & 0x01) ? neg_re : re;
+            B[k] = (R[k] & 0x01) ? neg_im : im;
+        }
+
+        for (unsigned u = 1; u < nb_stages + 1; u++) {
+            for (unsigned k = 0; k < K; k++) {
+                const int64_t sign = -int64_t((R[k] >> u) & 0x01); // -1 when Ri
+
+                const int64_t shifted_A = A[k] >> (u - 1);
+                const int64_t shifted_B = B[k] >> (u - 1);
+
+                // Conditional negations, wrapped on Out_W as in the ap_int datapath.
+                const int64_t arc_step_A = wrap((shifted_A ^ sign) - sign, Out_W);
+                const int64_t arc_step_B = wrap((shifted_B ^ ~sign) - ~sign, Out_W);
+
+                const int64_t I = wrap(A[k] + arc_step_B, Out_W);
+                B[k]            = wrap(B[k] + arc_step_A, Out_W);
+                A[k]            = I;
+            }
+        }
+    }
+
+public:
+    /// `bin_indexes` holds the `K` DFT bins to track, each lower than `N`.
+    explicit CCordicSlidingDFT(const unsigned * bin_indexes) {
+        for (unsigned k = 0; k < K; k++) {
+            bins[k]  = bin_indexes[k] % N;
+            steps[k] = (max_length - bins[k] * (max_length / N)) % max_length;
+        }
+        reset();
+    }
+
+    void reset() {
+        for (unsigned k = 0; k < K; k++) {
+            counters[k] = 0;
+            acc_re[k]   = 0;
+            acc_im[k]   = 0;
+        }
+        for (unsigned n = 0; n < N; n++) {
+            window_re[n] = 0;
+            window_im[n] = 0;
+        }
+        head = 0;
+    }
+
+    /// Slide the window by one `In_W`-bit sample, in O(K).
+    void push(int64_t re_in, int64_t im_in) {
+        uint8_t R[K];
+        for (unsigned k = 0; k < K; k++) {
+            R[k] = Cordic::rom_cordic.rom[counters[k]];
+        }
+
+        int64_t new_re[K], new_im[K], old_re[K], old_im[K];
+        rotate(re_in, im_in, R, new_re, new_im);
+        rotate(window_re[head], window_im[head], R, old_re, old_im);
+
+        for (unsigned k = 0; k < K; k++) {
+            acc_re[k] += new_re[k] - old_re[k];
+            acc_im[k] += new_im[k] - old_im[k];
+
+            const uint32_t next = counters[k] + steps[k];
+            counters[k]         = next >= max_length ? next - max_length : next;
+        }
+
+        window_re[head] = re_in;
+        window_im[head] = im_in;
+        head            = (head + 1) & (N - 1);
+    }
+
+    void process(const int64_t * re_in, const int64_t * im_in, size_t nb_samples) {
+        for (size_t n = 0; n < nb_samples; n++) {
+            push(re_in[n], im_in[n]);
+        }
+    }
+
+    unsigned bin_index(unsigned k) const {
+        return bins[k];
+    }
+
+    /// Raw accumulator of the `k`-th tracked bin, with the CORDIC gain, on `acc_W` bits.
+    std::complex<int64_t> accumulator(unsigned k) const {
+        return {acc_re[k], acc_im[k]};
+    }
+
+    /// `k`-th tracked bin, in the unit of the inputs (CORDIC gain compensated).
+    std::complex<double> bin(unsigned k) const {
+        const double scale = rcr::kn_values[nb_stages - 1] / double(uint64_t(1) << (Out_W - Cordic::Out_I));
+        return {double(acc_re[k]) * scale, double(acc_im[k]) * scale};
+    }
+};
+
+#endif // C_CORDIC_SLIDING_DFT_HPP
@@ -0,0 +1,192 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_STREAM_HPP
+#define C_CORDIC_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <ap_int.h>
+
+#include "CCordicStream/CStream.hpp"
+
+template <class Cordic>
+struct stream_input {
+    ap_int<Cordic::In_W>         re;
+    ap_int<Cordic::In_W>         im;
+    ap_uint<Cordic::addr_length> counter;
+};
+
+template <class Cordic>
+struct stream_output {
+    ap_int<Cordic::Out_W> re;
+    ap_int<Cordic::Out_W> im;
+};
+
+/**
+ * @brief Streaming top level: rotate `nb_samples` samples from `in` to `out`, one per cycle.
+ *
+ * `Cordic` is `CCordicRotateConstexpr` or a generated `CCordicRotateRom`. Any stream class with
+ * the `hls::stream` interface can be used, `CStream` being its software stand-in.
+ */
+template <class Cordic, template <class> class Stream = CStream>
+void cordic_stream_top(Stream<stream_input<Cordic>> & in, Stream<stream_output<Cordic>> & out, unsigned nb_samples) {
+    for (unsigned n = 0; n < nb_samples; n++) {
+#ifdef __SYNTHESIS__
+#pragma HLS PIPELINE II = 1
+#endif
+        const stream_input<Cordic> x = in.read();
+
+        stream_output<Cordic> y;
+        Cordic::cordic(x.re, x.im, x.counter, y.re, y.im);
+        out.write(y);
+    }
+}
+
+struct stream_report {
+    uint64_t cycles;
+    uint64_t samples_in;
+    uint64_t samples_out;
+    uint64_t stall_cycles;  ///< Cycles during which the pipeline was frozen by a full output.
+    uint64_t bubble_cycles; ///< Cycles during which the input was empty while the pipeline could accept.
+    unsigned min_latency;
+    unsigned max_latency;
+    double   mean_latency;
+    unsigned max_occupancy;
+    double   mean_occupancy; ///< Valid stage registers, per cycle.
+    double   throughput;     ///< Output samples per cycle.
+};
+
+/**
+ * @brief Cycle-level model of the stage registers of the streaming top level.
+ *
+ * The unrolled datapath is `Tlatency` registers deep (by default, the ROM read, the pi-rotation
+ * and one register per stage): each cycle, the last register is written to `out` and every
+ * register moves forward, the first one reading `in`, unless `out` is full, which freezes the
+ * whole pipeline as a blocking write does. Outputs are those of the `ap_int` `cordic` overload.
+ *
+ * Driving `in` and `out` with the expected producer and consumer patterns gives the latency,
+ * occupancy and throughput the HLS pipeline would reach, without running the vendor tools.
+ */
+template <class Cordic, unsigned Tlatency = Cordic::nb_stages + 2>
+class CCordicStreamModel {
+    static_assert(Tlatency > 0, "The pipeline has at least one register.");
+
+public:
+    static constexpr unsigned latency = Tlatency;
+
+    typedef stream_input<Cordic>  input_t;
+    typedef stream_output<Cordic> output_t;
+
+private:
+    struct stage_register {
+        bool     valid;
+        uint64_t entry_cycle;
+        output_t value;
+    };
+
+    CStream<input_t> &  in;
+    CStream<output_t> & out;
+
+    stage_register stages[latency];
+    stream_report  report;
+    uint64_t       latency_sum;
+    uint64_t       occupancy_sum;
+
+public:
+    CCordicStreamModel(CStream<input_t> & in, CStream<output_t> & out)
+        : in(in), out(out), stages(), report(), latency_sum(0), occupancy_sum(0) {
+        reset();
+    }
+
+    void reset() {
+        for (unsigned s = 0; s < latency; s++) {
+            stages[s].valid = false;
+        }
+        report        = stream_report {0, 0, 0, 0, 0, ~0U, 0, 0., 0, 0., 0.};
+        latency_sum   = 0;
+        occupancy_sum = 0;
+    }
+
+    /// Advance the pipeline by one clock cycle.
+    void tick() {
+        report.cycles++;
+
+        stage_register & last = stages[latency - 1];
+        if (last.valid) {
+            if (out.full()) {
+                report.stall_cycles++;
+                account_occupancy();
+                return;
+            }
+            out.write(last.value);
+
+            const unsigned sample_latency = unsigned(report.cycles - last.entry_cycle);
+            report.samples_out++;
+            report.min_latency = sample_latency < report.min_latency ? sample_latency : report.min_latency;
+            report.max_latency = sample_latency > report.max_latency ? sample_latency : report.max_latency;
+            latency_sum += sample_latency;
+        }
+
+        for (unsigned s = latency - 1; s > 0; s--) {
+            stages[s] = stages[s - 1];
+        }
+
+        input_t x;
+        if (in.read_nb(x)) {
+            stages[0].valid       = true;
+            stages[0].entry_cycle = report.cycles;
+            Cordic::cordic(x.re, x.im, x.counter, stages[0].value.re, stages[0].value.im);
+            report.samples_in++;
+        } else {
+            stages[0].valid = false;
+            report.bubble_cycles++;
+        }
+
+        account_occupancy();
+    }
+
+    /// Valid stage registers.
+    unsigned occupancy() const {
+        unsigned valid = 0;
+        for (unsigned s = 0; s < latency; s++) {
+            valid += stages[s].valid ? 1 : 0;
+        }
+        return valid;
+    }
+
+    stream_report stats() const {
+        stream_report r  = report;
+        r.min_latency    = r.samples_out > 0 ? r.min_latency : 0;
+        r.mean_latency   = r.samples_out > 0 ? double(latency_sum) / double(r.samples_out) : 0.;
+        r.mean_occupancy = r.cycles > 0 ? double(occupancy_sum) / double(r.cycles) : 0.;
+        r.throughput     = r.cycles > 0 ? double(r.samples_out) / double(r.cycles) : 0.;
+        return r;
+    }
+
+private:
+    void account_occupancy() {
+        const unsigned valid = occupancy();
+        occupancy_sum += valid;
+        report.max_occupancy = valid > report.max_occupancy ? valid : report.max_occupancy;
+    }
+};
+
+#endif // C_CORDIC_STREAM_HPP
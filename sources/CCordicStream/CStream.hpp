@@ -0,0 +1,112 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_STREAM_HPP
+#define C_STREAM_HPP
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+
+/**
+ * @brief Software stand-in for `hls::stream`, with an optional depth.
+ *
+ * The interface is the one of `hls::stream`. When `depth` is not 0 the FIFO is bounded, so that
+ * cycle models can see backpressure; a blocking `write` on a full stream, or a blocking `read`
+ * on an empty one, is a deadlock in hardware and aborts.
+ */
+template <class T>
+class CStream {
+    std::deque<T> fifo;
+    const size_t  fifo_depth;
+
+public:
+    explicit CStream(size_t depth = 0) : fifo(), fifo_depth(depth) {}
+
+    CStream(const CStream &)             = delete;
+    CStream & operator=(const CStream &) = delete;
+
+    bool empty() const {
+        return fifo.empty();
+    }
+
+    bool full() const {
+        return fifo_depth != 0 && fifo.size() >= fifo_depth;
+    }
+
+    size_t size() const {
+        return fifo.size();
+    }
+
+    size_t depth() const {
+        return fifo_depth;
+    }
+
+    void read(T & value) {
+        if (empty()) {
+            fprintf(stderr, "CStream: blocking read on an empty stream.\n");
+            abort();
+        }
+        value = fifo.front();
+        fifo.pop_front();
+    }
+
+    T read() {
+        T value;
+        read(value);
+        return value;
+    }
+
+    bool read_nb(T & value) {
+        if (empty()) {
+            return false;
+        }
+        read(value);
+        return true;
+    }
+
+    void write(const T & value) {
+        if (full()) {
+            fprintf(stderr, "CStream: blocking write on a full stream.\n");
+            abort();
+        }
+        fifo.push_back(value);
+    }
+
+    bool write_nb(const T & value) {
+        if (full()) {
+            return false;
+        }
+        fifo.push_back(value);
+        return true;
+    }
+
+    CStream & operator>>(T & value) {
+        read(value);
+        return *this;
+    }
+
+    CStream & operator<<(const T & value) {
+        write(value);
+        return *this;
+    }
+};
+
+#endif // C_STREAM_HPP
@@ -0,0 +1,212 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicTrace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+
+template <class T>
+static bool write_column(FILE * trace_file, const std::vector<T> & column, unsigned bytes) {
+    if (column.empty()) {
+        return true;
+    }
+
+    if (bytes == 4) {
+        return fwrite(column.data(), sizeof(T), column.size(), trace_file) == column.size();
+    }
+
+    std::vector<uint16_t> narrow(column.size());
+    for (size_t i = 0; i < column.size(); i++) {
+        narrow[i] = uint16_t(column[i]);
+    }
+    return fwrite(narrow.data(), sizeof(uint16_t), narrow.size(), trace_file) == narrow.size();
+}
+
+// Narrow columns are sign-extended for int32_t, zero-extended for uint32_t.
+template <class T>
+static bool read_column(FILE * trace_file, std::vector<T> & column, size_t count, unsigned bytes) {
+    column.resize(count);
+    if (count == 0) {
+        return true;
+    }
+
+    if (bytes == 4) {
+        return fread(column.data(), sizeof(T), count, trace_file) == count;
+    }
+
+    std::vector<uint16_t> narrow(count);
+    if (fread(narrow.data(), sizeof(uint16_t), count, trace_file) != count) {
+        return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+        column[i] = std::numeric_limits<T>::is_signed ? T(int16_t(narrow[i])) : T(narrow[i]);
+    }
+    return true;
+}
+
+static unsigned column_bytes(unsigned bits) {
+    return bits <= 16 ? 2 : 4;
+}
+
+bool CCordicTrace::save(const char * filename) const {
+    FILE * trace_file = fopen(filename, "wb");
+    if (!bool(trace_file)) {
+        perror("Can't open the trace for writing.");
+        return false;
+    }
+
+    rcr::trace_header header {};
+    memcpy(header.magic, rcr::trace_magic, sizeof(header.magic));
+    header.version       = rcr::trace_version;
+    header.In_W          = uint8_t(In_W);
+    header.In_I          = uint8_t(In_I);
+    header.Out_W         = uint8_t(Out_W);
+    header.nb_stages     = uint8_t(nb_stages);
+    header.q             = q;
+    header.divider       = divider;
+    header.max_length    = max_length;
+    header.in_bytes      = uint8_t(column_bytes(In_W));
+    header.out_bytes     = uint8_t(column_bytes(Out_W));
+    header.counter_bytes = uint8_t(max_length <= (1U << 16) ? 2 : 4);
+    header.has_outputs   = has_outputs() ? 1 : 0;
+    header.rom_type      = uint8_t(rom_type);
+    header.count         = size();
+    header.seen          = seen;
+
+    bool ok = fwrite(&header, sizeof(header), 1, trace_file) == 1;
+    ok      = ok && write_column(trace_file, re_in, header.in_bytes);
+    ok      = ok && write_column(trace_file, im_in, header.in_bytes);
+    ok      = ok && write_column(trace_file, counters, header.counter_bytes);
+    if (has_outputs()) {
+        ok = ok && write_column(trace_file, re_out, header.out_bytes);
+        ok = ok && write_column(trace_file, im_out, header.out_bytes);
+    }
+
+    if (fclose(trace_file) != 0 || !ok) {
+        perror("Can't write the trace.");
+        return false;
+    }
+    return true;
+}
+
+bool CCordicTrace::load(const char * filename) {
+    *this = CCordicTrace();
+
+    FILE * trace_file = fopen(filename, "rb");
+    if (!bool(trace_file)) {
+        perror("Can't open the trace.");
+        return false;
+    }
+
+    rcr::trace_header header {};
+    bool valid = fread(&header, sizeof(header), 1, trace_file) == 1
+              && memcmp(header.magic, rcr::trace_magic, sizeof(rcr::trace_magic)) == 0
+              && header.version == rcr::trace_version
+              && header.In_W > 0 && header.In_W <= 32 && header.Out_W <= 32
+              && header.max_length > 0
+              && header.in_bytes == column_bytes(header.In_W)
+              && header.out_bytes == column_bytes(header.Out_W)
+              && (header.counter_bytes == 2 || header.counter_bytes == 4)
+              && header.rom_type <= uint8_t(rcr::generator_type::cst);
+
+    // The header count must match the file size before any column is allocated.
+    if (valid) {
+        const uint64_t sample_bytes = 2U * header.in_bytes + header.counter_bytes + (header.has_outputs != 0 ? 2U * header.out_bytes : 0U);
+
+        valid                 = fseek(trace_file, 0, SEEK_END) == 0;
+        const long file_size  = valid ? ftell(trace_file) : -1;
+        valid                 = file_size >= long(sizeof(header))
+             && uint64_t(file_size) - sizeof(header) == header.count * sample_bytes
+             && header.count <= (uint64_t(file_size) - sizeof(header)) / sample_bytes
+             && fseek(trace_file, long(sizeof(header)), SEEK_SET) == 0;
+    }
+
+    if (valid) {
+        const size_t count = size_t(header.count);
+
+        valid = read_column(trace_file, re_in, count, header.in_bytes)
+             && read_column(trace_file, im_in, count, header.in_bytes)
+             && read_column(trace_file, counters, count, header.counter_bytes);
+        if (valid && header.has_outputs != 0) {
+            valid = read_column(trace_file, re_out, count, header.out_bytes)
+                 && read_column(trace_file, im_out, count, header.out_bytes);
+        }
+        valid = valid && fgetc(trace_file) == EOF;
+        valid = valid && std::all_of(counters.begin(), counters.end(), [&](uint32_t c) { return c < header.max_length; });
+    }
+    fclose(trace_file);
+
+    if (!valid) {
+        fprintf(stderr, "%s is not a valid version %u CORDIC trace.\n", filename, rcr::trace_version);
+        *this = CCordicTrace();
+        return false;
+    }
+
+    In_W       = header.In_W;
+    In_I       = header.In_I;
+    Out_W      = header.Out_W;
+    nb_stages  = header.nb_stages;
+    q          = header.q;
+    divider    = header.divider;
+    max_length = header.max_length;
+    seen       = header.seen;
+    rom_type   = rcr::generator_type(header.rom_type);
+    return true;
+}
+
+replay_report replay_trace(const CCordicRotator & rotator, const CCordicTrace & trace, unsigned repetitions) {
+    replay_report report {};
+    report.compatible = rotator.In_W == trace.In_W && rotator.In_I == trace.In_I && rotator.Out_W == trace.Out_W
+                     && rotator.nb_stages == trace.nb_stages && rotator.q == trace.q && rotator.divider == trace.divider
+                     && rotator.rom_type == trace.rom_type;
+    report.samples        = trace.size();
+    report.first_mismatch = trace.size();
+
+    if (!report.compatible || trace.size() == 0) {
+        return report;
+    }
+
+    const size_t         length = trace.size();
+    std::vector<int32_t> re(length), im(length);
+
+    double best_ns = std::numeric_limits<double>::infinity();
+    for (unsigned r = 0; r < std::max(repetitions, 1U); r++) {
+        const auto start = std::chrono::steady_clock::now();
+        rotator.cordic(trace.re_in.data(), trace.im_in.data(), trace.counters.data(), re.data(), im.data(), length);
+        const auto stop = std::chrono::steady_clock::now();
+
+        best_ns = std::min(best_ns, std::chrono::duration<double, std::nano>(stop - start).count() / double(length));
+    }
+    report.ns_per_sample  = best_ns;
+    report.msamples_per_s = best_ns > 0. ? 1e3 / best_ns : std::numeric_limits<double>::infinity();
+
+    if (trace.has_outputs()) {
+        for (size_t i = 0; i < length; i++) {
+            if (re[i] != trace.re_out[i] || im[i] != trace.im_out[i]) {
+                report.first_mismatch = std::min(report.first_mismatch, i);
+                report.mismatches++;
+            }
+        }
+    }
+    return report;
+}
@@ -0,0 +1,249 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef C_CORDIC_TRACE_HPP
+#define C_CORDIC_TRACE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <ap_int.h>
+
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+
+/**
+ * @file CCordicTrace.hpp
+ * Capture of the (re, im, counter) streams of a live rotator, and their offline replay.
+ *
+ * Layout (native endianness), columns on the fewest of 2 or 4 bytes their width allows:
+ * | trace_header | re_in[count] | im_in[count] | counters[count] | re_out[count] | im_out[count] |
+ */
+
+namespace rom_cordic_rotate {
+
+constexpr char     trace_magic[8] = {'C', 'O', 'R', 'D', 'T', 'R', 'C', 'E'};
+constexpr uint32_t trace_version  = 2;
+
+struct trace_header {
+    char     magic[8];
+    uint32_t version;
+    uint8_t  In_W;
+    uint8_t  In_I;
+    uint8_t  Out_W;
+    uint8_t  nb_stages;
+    uint32_t q;
+    uint32_t divider;
+    uint32_t max_length;
+    uint8_t  in_bytes;
+    uint8_t  out_bytes;
+    uint8_t  counter_bytes;
+    uint8_t  has_outputs;
+    uint8_t  rom_type; // generator_type
+    uint8_t  reserved[7];
+    uint64_t count;
+    uint64_t seen; // Samples rotated during the capture, recorded or not.
+};
+
+static_assert(sizeof(trace_header) == 56, "Unexpected padding in trace_header.");
+
+} // namespace rom_cordic_rotate
+
+namespace rcr = rom_cordic_rotate;
+
+/// Recorded samples, as the `int32_t` raw `ap_int` values of the CCordicRotator block interface.
+class CCordicTrace {
+public:
+    unsigned In_W       = 0;
+    unsigned In_I       = 0;
+    unsigned Out_W      = 0;
+    unsigned nb_stages  = 0;
+    unsigned q          = 0;
+    unsigned divider    = 0;
+    unsigned max_length = 0;
+    uint64_t seen       = 0;
+
+    rcr::generator_type rom_type = rcr::generator_type::cst;
+
+    std::vector<int32_t>  re_in;
+    std::vector<int32_t>  im_in;
+    std::vector<uint32_t> counters;
+    std::vector<int32_t>  re_out; // Empty when the outputs were not recorded.
+    std::vector<int32_t>  im_out;
+
+    size_t size() const { return counters.size(); }
+
+    bool has_outputs() const { return !counters.empty() && re_out.size() == counters.size(); }
+
+    /// Write the trace, returns false on I/O error.
+    bool save(const char * filename) const;
+
+    /// Read and validate `filename`, returns false (leaving the trace empty) on error.
+    bool load(const char * filename);
+};
+
+enum class capture_mode : uint8_t {
+    full    = 0, ///< Every sample.
+    sampled = 1, ///< One sample every `parameter`.
+    ring    = 2  ///< The last `parameter` samples.
+};
+
+/**
+ * @brief Recording wrapper around the `ap_int` and block interfaces of a rotator.
+ *
+ * `Cordic` is any class exposing the static interface of `CCordicRotateConstexpr`. Outputs are
+ * those of `Cordic`; recording only costs a few stores per sample (the ring mode never allocates
+ * after construction), so the wrapper can stay in a deployed build.
+ * ``` C++
+ * CCordicCapture<cordic> capture(capture_mode::ring, 1U << 20);
+ * capture.cordic(re_in, im_in, counter, re_out, im_out);
+ * capture.trace().save("field.trace");
+ * ```
+ */
+template <class Cordic>
+class CCordicCapture {
+    static_assert(Cordic::Out_W <= 32, "Traced rotators must fit int32_t outputs.");
+
+    const capture_mode mode;
+    const size_t       parameter;
+    const bool         with_outputs;
+
+    CCordicTrace records;
+    size_t       next;  // Next slot of the ring.
+    uint64_t     count; // Samples until the next sampled one.
+
+    void record(int32_t re_in, int32_t im_in, uint32_t counter, int32_t re_out, int32_t im_out) {
+        records.seen++;
+
+        if (mode == capture_mode::sampled) {
+            if (--count != 0) {
+                return;
+            }
+            count = parameter;
+        }
+
+        if (mode == capture_mode::ring) {
+            records.re_in[next]    = re_in;
+            records.im_in[next]    = im_in;
+            records.counters[next] = counter;
+            if (with_outputs) {
+                records.re_out[next] = re_out;
+                records.im_out[next] = im_out;
+            }
+            next = next + 1 == parameter ? 0 : next + 1;
+            return;
+        }
+
+        records.re_in.push_back(re_in);
+        records.im_in.push_back(im_in);
+        records.counters.push_back(counter);
+        if (with_outputs) {
+            records.re_out.push_back(re_out);
+            records.im_out.push_back(im_out);
+        }
+    }
+
+public:
+    /// `parameter` is the sampling period or the ring length, ignored in `full` mode.
+    explicit CCordicCapture(capture_mode mode = capture_mode::full, size_t parameter = 1, bool with_outputs = true)
+        : mode(mode), parameter(parameter > 0 ? parameter : 1), with_outputs(with_outputs), next(0), count(this->parameter) {
+        records.In_W       = Cordic::In_W;
+        records.In_I       = Cordic::In_I;
+        records.Out_W      = Cordic::Out_W;
+        records.nb_stages  = Cordic::nb_stages;
+        records.q          = Cordic::q;
+        records.divider    = Cordic::divider;
+        records.max_length = Cordic::max_length;
+        records.rom_type   = Cordic::rom_type;
+
+        if (mode == capture_mode::ring) {
+            records.re_in.resize(this->parameter);
+            records.im_in.resize(this->parameter);
+            records.counters.resize(this->parameter);
+            if (with_outputs) {
+                records.re_out.resize(this->parameter);
+                records.im_out.resize(this->parameter);
+            }
+        }
+    }
+
+    void cordic(const ap_int<Cordic::In_W> & re_in, const ap_int<Cordic::In_W> & im_in,
+                const ap_uint<Cordic::addr_length> & counter,
+                ap_int<Cordic::Out_W> & re_out, ap_int<Cordic::Out_W> & im_out) {
+        Cordic::cordic(re_in, im_in, counter, re_out, im_out);
+        record(int32_t(re_in.to_int64()), int32_t(im_in.to_int64()), uint32_t(counter.to_uint64()),
+               int32_t(re_out.to_int64()), int32_t(im_out.to_int64()));
+    }
+
+    /// Same contract as `CCordicRotator::cordic`.
+    void cordic(const int32_t * re_in, const int32_t * im_in, const uint32_t * counters,
+                int32_t * re_out, int32_t * im_out, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            ap_int<Cordic::Out_W> re, im;
+            cordic(ap_int<Cordic::In_W>(re_in[i]), ap_int<Cordic::In_W>(im_in[i]), ap_uint<Cordic::addr_length>(counters[i]), re, im);
+            re_out[i] = int32_t(re.to_int64());
+            im_out[i] = int32_t(im.to_int64());
+        }
+    }
+
+    uint64_t seen() const { return records.seen; }
+
+    /// The recorded samples, oldest first.
+    CCordicTrace trace() const {
+        if (mode != capture_mode::ring) {
+            return records;
+        }
+
+        const size_t length = records.seen < parameter ? size_t(records.seen) : parameter;
+        const size_t first  = records.seen < parameter ? 0 : next;
+
+        CCordicTrace ordered = records;
+        ordered.re_in.resize(length);
+        ordered.im_in.resize(length);
+        ordered.counters.resize(length);
+        ordered.re_out.resize(with_outputs ? length : 0);
+        ordered.im_out.resize(with_outputs ? length : 0);
+
+        for (size_t i = 0; i < length; i++) {
+            const size_t j      = (first + i) % parameter;
+            ordered.re_in[i]    = records.re_in[j];
+            ordered.im_in[i]    = records.im_in[j];
+            ordered.counters[i] = records.counters[j];
+            if (with_outputs) {
+                ordered.re_out[i] = records.re_out[j];
+                ordered.im_out[i] = records.im_out[j];
+            }
+        }
+        return ordered;
+    }
+};
+
+struct replay_report {
+    bool     compatible;    ///< The rotator has the configuration of the trace.
+    size_t   samples;
+    double   ns_per_sample; ///< Best of the repetitions.
+    double   msamples_per_s;
+    size_t   mismatches;    ///< Outputs differing from the recorded ones, 0 without recorded outputs.
+    size_t   first_mismatch;
+};
+
+/// Rotate the whole trace `repetitions` times through `rotator`, and compare with the recorded outputs.
+replay_report replay_trace(const CCordicRotator & rotator, const CCordicTrace & trace, unsigned repetitions = 5);
+
+#endif // C_CORDIC_TRACE_HPP
@@ -0,0 +1,191 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "cordic_c.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CCordicProfiler/CCordicProfiler.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+
+struct cordic_c_rotator {
+    const CCordicRotator & impl;
+    const double           in_scale;
+};
+
+namespace {
+
+// Block size of the int16_t and float entry points, converted through stack buffers.
+constexpr size_t chunk_length = 256;
+
+template <class Cordic>
+const cordic_c_rotator * registered() {
+    static const CCordicRotatorInstance<Cordic> impl;
+    static const cordic_c_rotator               rotator {impl, double(Cordic::in_scale_factor)};
+    return &rotator;
+}
+
+const cordic_c_rotator * const rotators[] = {
+    registered<CCordicRotateConstexpr<16, 4, 6, 64, 2>>(),
+    registered<CCordicRotateConstexpr<16, 4, 6, 64, 4>>(),
+    registered<CCordicRotateConstexpr<16, 4, 7, 256, 2>>(),
+    registered<CCordicRotateConstexpr<16, 1, 7, 256, 2>>(),
+    registered<CCordicRotateConstexpr<14, 2, 5, 128, 2>>(),
+    registered<CCordicRotateConstexpr<12, 4, 4, 64, 4>>(),
+    registered<CCordicRotateConstexpr<8, 2, 4, 32, 2>>(),
+};
+
+constexpr size_t nb_rotators = sizeof(rotators) / sizeof(rotators[0]);
+
+inline uint32_t advance(const CCordicRotator & impl, uint32_t counter, size_t length) {
+    return uint32_t((uint64_t(counter) + length) % impl.max_length);
+}
+
+} // namespace
+
+extern "C" {
+
+size_t cordic_c_count(void) {
+    return nb_rotators;
+}
+
+const cordic_c_rotator * cordic_c_at(size_t index) {
+    return index < nb_rotators ? rotators[index] : nullptr;
+}
+
+const cordic_c_rotator * cordic_c_find(unsigned in_w, unsigned in_i, unsigned nb_stages, unsigned q, unsigned divider) {
+    for (const cordic_c_rotator * r : rotators) {
+        const CCordicRotator & impl = r->impl;
+        if (impl.In_W == in_w && impl.In_I == in_i && impl.nb_stages == nb_stages && impl.q == q && impl.divider == divider) {
+            return r;
+        }
+    }
+    return nullptr;
+}
+
+cordic_c_config cordic_c_get_config(const cordic_c_rotator * rotator) {
+    const CCordicRotator & impl = rotator->impl;
+    return {impl.In_W, impl.In_I, impl.Out_W, impl.Out_I, impl.nb_stages, impl.q, impl.divider, impl.max_length};
+}
+
+cordic_c_semantics cordic_c_get_semantics(void) {
+    return {
+        CORDIC_C_FLOOR,
+        CORDIC_C_WRAP,
+        CORDIC_C_WRAP,
+        CORDIC_C_FLOOR,
+        CORDIC_C_TRUNCATE,
+        CORDIC_C_SATURATE,
+        "Bit-exact with the ap_int datapath of CCordicRotateConstexpr: stage shifts are arithmetic "
+        "(floor), the out_w-bit datapath wraps around, and the pi-rotation negates on in_w bits, "
+        "so -2^(in_w - 1) is left unchanged. Gain compensation multiplies by the 4-bit kn then shifts "
+        "right by 4 (floor). Float samples are truncated towards zero on in_w bits, after saturation; "
+        "int16_t outputs are saturated."};
+}
+
+uint32_t cordic_c_rotate_i32(const cordic_c_rotator * rotator,
+                             const int32_t * re_in, const int32_t * im_in,
+                             int32_t * re_out, int32_t * im_out,
+                             size_t length, uint32_t counter) {
+    CORDIC_PROFILE_SCOPE("cordic_c_rotate_i32", length);
+    const CCordicRotator & impl = rotator->impl;
+    counter %= impl.max_length;
+    impl.cordic(re_in, im_in, counter, re_out, im_out, length);
+    return advance(impl, counter, length);
+}
+
+void cordic_c_scale_i32(const cordic_c_rotator * rotator, int32_t * values, size_t length) {
+    rotator->impl.scale_cordic(values, length);
+}
+
+uint32_t cordic_c_rotate_i16(const cordic_c_rotator * rotator,
+                             const int16_t * re_in, const int16_t * im_in,
+                             int16_t * re_out, int16_t * im_out,
+                             size_t length, uint32_t counter) {
+    CORDIC_PROFILE_SCOPE("cordic_c_rotate_i16", length);
+    const CCordicRotator & impl = rotator->impl;
+    if (impl.In_W > 16) {
+        return UINT32_MAX;
+    }
+    counter %= impl.max_length;
+
+    int32_t re[chunk_length];
+    int32_t im[chunk_length];
+
+    for (size_t start = 0; start < length; start += chunk_length) {
+        const size_t n = std::min(chunk_length, length - start);
+
+        std::copy(re_in + start, re_in + start + n, re);
+        std::copy(im_in + start, im_in + start + n, im);
+
+        impl.cordic(re, im, counter, re, im, n);
+        impl.scale_cordic(re, n);
+        impl.scale_cordic(im, n);
+
+        for (size_t i = 0; i < n; i++) {
+            re_out[start + i] = int16_t(std::min<int32_t>(INT16_MAX, std::max<int32_t>(INT16_MIN, re[i])));
+            im_out[start + i] = int16_t(std::min<int32_t>(INT16_MAX, std::max<int32_t>(INT16_MIN, im[i])));
+        }
+        counter = advance(impl, counter, n);
+    }
+    return counter;
+}
+
+uint32_t cordic_c_rotate_f32(const cordic_c_rotator * rotator,
+                             const float * re_in, const float * im_in,
+                             float * re_out, float * im_out,
+                             size_t length, uint32_t counter) {
+    CORDIC_PROFILE_SCOPE("cordic_c_rotate_f32", length);
+    const CCordicRotator & impl = rotator->impl;
+    counter %= impl.max_length;
+
+    const double  in_scale  = rotator->in_scale;
+    const double  out_scale = 1. / in_scale; // Out_W - Out_I == In_W - In_I
+    const int32_t in_max    = int32_t((int64_t(1) << (impl.In_W - 1)) - 1);
+    const int32_t in_min    = -in_max - 1;
+
+    int32_t re[chunk_length];
+    int32_t im[chunk_length];
+
+    for (size_t start = 0; start < length; start += chunk_length) {
+        const size_t n = std::min(chunk_length, length - start);
+
+        for (size_t i = 0; i < n; i++) {
+            const double re_fx = std::trunc(double(re_in[start + i]) * in_scale);
+            const double im_fx = std::trunc(double(im_in[start + i]) * in_scale);
+            re[i]              = int32_t(std::min<double>(in_max, std::max<double>(in_min, re_fx)));
+            im[i]              = int32_t(std::min<double>(in_max, std::max<double>(in_min, im_fx)));
+        }
+
+        impl.cordic(re, im, counter, re, im, n);
+        impl.scale_cordic(re, n);
+        impl.scale_cordic(im, n);
+
+        for (size_t i = 0; i < n; i++) {
+            re_out[start + i] = float(double(re[i]) * out_scale);
+            im_out[start + i] = float(double(im[i]) * out_scale);
+        }
+        counter = advance(impl, counter, n);
+    }
+    return counter;
+}
+
+} // extern "C"
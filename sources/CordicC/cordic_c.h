@@ -0,0 +1,124 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_c.h
+ * Plain C interface to a registered set of precompiled ROM-based CORDIC rotators.
+ *
+ * Rotators have a static lifetime: they are looked up, never created nor freed.
+ * Every rotation works on caller-owned buffers, out of place or in place (output pointers
+ * may be equal to the input ones), and never allocates.
+ * Sample `i` of a call is rotated by `(counter + i) % max_length`, the returned value being
+ * the counter of the next sample, so that a stream can be processed in successive calls.
+ */
+
+#ifndef CORDIC_C_H
+#define CORDIC_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define CORDIC_C_API __declspec(dllexport)
+#else
+#define CORDIC_C_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct cordic_c_rotator cordic_c_rotator;
+
+typedef struct cordic_c_config {
+    unsigned in_w;
+    unsigned in_i;
+    unsigned out_w;
+    unsigned out_i;
+    unsigned nb_stages;
+    unsigned q;
+    unsigned divider;
+    unsigned max_length;
+} cordic_c_config;
+
+typedef enum cordic_c_rounding {
+    CORDIC_C_FLOOR,    /**< Arithmetic right shift, rounding towards minus infinity. */
+    CORDIC_C_TRUNCATE, /**< Rounding towards zero. */
+    CORDIC_C_WRAP,     /**< Two's complement wrap-around. */
+    CORDIC_C_SATURATE  /**< Clamp to the representable range. */
+} cordic_c_rounding;
+
+typedef struct cordic_c_semantics {
+    cordic_c_rounding stage_shift;    /**< Shifts of the CORDIC stages. */
+    cordic_c_rounding stage_overflow; /**< Overflows of the Out_W-bit datapath. */
+    cordic_c_rounding input_negation; /**< Pi-rotation of -2^(in_w - 1), negated on in_w bits. */
+    cordic_c_rounding gain_scaling;   /**< Gain compensation (4-bit kn product then shift). */
+    cordic_c_rounding float_input;    /**< Conversion of float samples to in_w-bit integers. */
+    cordic_c_rounding int16_output;   /**< Conversion of the scaled outputs to int16_t. */
+    const char *      description;
+} cordic_c_semantics;
+
+/** Number of registered configurations. */
+CORDIC_C_API size_t cordic_c_count(void);
+
+/** Registered rotator number `index`, or NULL if `index >= cordic_c_count()`. */
+CORDIC_C_API const cordic_c_rotator * cordic_c_at(size_t index);
+
+/** Registered rotator of this configuration, or NULL if it has not been registered. */
+CORDIC_C_API const cordic_c_rotator * cordic_c_find(unsigned in_w, unsigned in_i, unsigned nb_stages,
+                                                    unsigned q, unsigned divider);
+
+CORDIC_C_API cordic_c_config cordic_c_get_config(const cordic_c_rotator * rotator);
+
+/** Rounding and overflow behaviour of every entry point, identical for all configurations. */
+CORDIC_C_API cordic_c_semantics cordic_c_get_semantics(void);
+
+/**
+ * Raw rotation: inputs are in_w-bit integers, outputs the out_w-bit integers of the CORDIC,
+ * gain included (see cordic_c_scale_i32).
+ */
+CORDIC_C_API uint32_t cordic_c_rotate_i32(const cordic_c_rotator * rotator,
+                                          const int32_t * re_in, const int32_t * im_in,
+                                          int32_t * re_out, int32_t * im_out,
+                                          size_t length, uint32_t counter);
+
+/** Compensate the CORDIC gain of raw outputs, in place. */
+CORDIC_C_API void cordic_c_scale_i32(const cordic_c_rotator * rotator, int32_t * values, size_t length);
+
+/**
+ * Gain-compensated rotation of in_w-bit integers, the outputs sharing the fixed-point format
+ * of the inputs and saturated to int16_t.
+ * Requires in_w <= 16: otherwise nothing is done and UINT32_MAX is returned.
+ */
+CORDIC_C_API uint32_t cordic_c_rotate_i16(const cordic_c_rotator * rotator,
+                                          const int16_t * re_in, const int16_t * im_in,
+                                          int16_t * re_out, int16_t * im_out,
+                                          size_t length, uint32_t counter);
+
+/** Gain-compensated rotation of real-valued samples, quantized on in_w bits (in_i integer bits). */
+CORDIC_C_API uint32_t cordic_c_rotate_f32(const cordic_c_rotator * rotator,
+                                          const float * re_in, const float * im_in,
+                                          float * re_out, float * im_out,
+                                          size_t length, uint32_t counter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CORDIC_C_H */
@@ -0,0 +1,50 @@
+/** @file cordic_rom_ml_16_6_64_2.hpp
+ * THIS FILE IS GENERATED AUTOMATICALY, DO NOT EDIT IT!
+ */
+#ifndef CORDIC_ROMS_ML_16_6_64_2
+#define CORDIC_ROMS_ML_16_6_64_2
+
+#include <cstdint>
+
+namespace cordic_roms {
+
+constexpr uint64_t ml_16_6_64_2_size = 256;
+
+constexpr uint8_t  ml_16_6_64_2[256] = {
+   34,  34,  28,  66, 108, 108,   2,  44, 
+   44,  76,  76,  12,  12,  12, 116, 116, 
+   52,  52,  52,  84,  84,  20,  20,  20, 
+  100, 100,  36,  36,  36,  68,  68,   4, 
+  120, 120,  56,  56,  88,  88,  88,  24, 
+   24, 104, 104, 104,  40,  40,  72,  72, 
+   72,   8,   8, 112, 112, 112,  48,  48, 
+   80,  80, 127,  16,  16,  63,  96,  95, 
+   32,  32,  31,  64, 111, 111,   0,  47, 
+   47,  79,  79,  15,  15,  15, 119, 119, 
+   55,  55,  55,  87,  87,  23,  23,  23, 
+  103, 103,  39,  39,  39,  71,  71,   7, 
+    7, 123,  59,  59,  91,  91,  91,  27, 
+   27, 107, 107, 107,  43,  43,  75,  75, 
+   75,  11,  11, 115, 115, 115,  51,  51, 
+   83,  83, 125,  19,  19,  61,  99,  93, 
+   93,  35,  29,  67, 109, 109,   3,  45, 
+   45,  77,  77,  13,  13,  13, 117, 117, 
+   53,  53,  53,  85,  85,  21,  21,  21, 
+  101, 101,  37,  37,  37,  69,  69,   5, 
+    5, 121,  57,  57,  89,  89,  89,  25, 
+   25, 105, 105, 105,  41,  41,  73,  73, 
+   73,   9,   9, 113, 113, 113,  49,  49, 
+   81,  81, 126,  17,  17,  62,  97,  94, 
+   94,  33,  30,  65, 110, 110,   1,  46, 
+   46,  78,  78,  14,  14,  14, 118, 118, 
+   54,  54,  54,  86,  86,  22,  22,  22, 
+  102, 102,  38,  38,  38,  70,  70,   6, 
+    6, 122,  58,  58,  90,  90,  90,  26, 
+   26, 106, 106, 106,  42,  42,  74,  74, 
+   74,  10,  10, 114, 114, 114,  50,  50, 
+   82,  82, 124,  18,  18,  60,  98,  92};
+
+} // namespace cordic_roms
+
+#endif // CORDIC_ROMS_ML_16_6_64_2
+
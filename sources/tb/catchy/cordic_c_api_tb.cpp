@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CordicC/cordic_c.h"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+TEST_CASE("C interface exposes the registered configurations", "[C_API]") {
+    REQUIRE(cordic_c_count() > 0);
+    REQUIRE(cordic_c_at(cordic_c_count()) == nullptr);
+
+    for (size_t i = 0; i < cordic_c_count(); i++) {
+        const cordic_c_config config = cordic_c_get_config(cordic_c_at(i));
+        REQUIRE(cordic_c_find(config.in_w, config.in_i, config.nb_stages, config.q, config.divider) == cordic_c_at(i));
+        REQUIRE(config.out_w == config.in_w + 2);
+        REQUIRE(config.max_length == 2 * config.divider * config.q);
+    }
+
+    REQUIRE(cordic_c_find(16, 4, 6, 64, 2) != nullptr);
+    REQUIRE(cordic_c_find(16, 4, 6, 63, 2) == nullptr);
+
+    const cordic_c_semantics semantics = cordic_c_get_semantics();
+    REQUIRE(semantics.stage_shift == CORDIC_C_FLOOR);
+    REQUIRE(semantics.stage_overflow == CORDIC_C_WRAP);
+    REQUIRE(semantics.description != nullptr);
+}
+
+TEST_CASE("C interface is bit-exact with the templates, in and out of place", "[C_API]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 4> cordic_rom;
+
+    const cordic_c_rotator * rotator = cordic_c_find(16, 4, 6, 64, 4);
+    REQUIRE(rotator != nullptr);
+
+    constexpr size_t   length     = 1000;
+    constexpr uint32_t max_length = cordic_rom::max_length;
+
+    vector<int32_t> re(length), im(length), re_out(length), im_out(length);
+    vector<int16_t> re16(length), im16(length);
+    for (size_t i = 0; i < length; i++) {
+        re[i]   = int32_t((int64_t(i) * 7919) % 65535 - 32767);
+        im[i]   = int32_t((int64_t(i) * 104729) % 65535 - 32767);
+        re16[i] = int16_t(re[i]);
+        im16[i] = int16_t(im[i]);
+    }
+
+    // Two calls, the second one continuing the counter of the first.
+    uint32_t counter = cordic_c_rotate_i32(rotator, re.data(), im.data(), re_out.data(), im_out.data(), 300, 500);
+    REQUIRE(counter == (500 + 300) % max_length);
+    counter = cordic_c_rotate_i32(rotator, re.data() + 300, im.data() + 300, re_out.data() + 300, im_out.data() + 300, length - 300, counter);
+    REQUIRE(counter == (500 + length) % max_length);
+
+    vector<int16_t> re16_out(re16), im16_out(im16);
+    cordic_c_rotate_i16(rotator, re16_out.data(), im16_out.data(), re16_out.data(), im16_out.data(), length, 500);
+
+    for (size_t i = 0; i < length; i++) {
+        ap_int<cordic_rom::Out_W> re_ref, im_ref;
+        cordic_rom::cordic(re[i], im[i], (500 + i) % max_length, re_ref, im_ref);
+
+        REQUIRE(re_out[i] == re_ref.to_int());
+        REQUIRE(im_out[i] == im_ref.to_int());
+
+        const int32_t re_scaled = cordic_rom::scale_cordic(re_ref).to_int();
+        const int32_t im_scaled = cordic_rom::scale_cordic(im_ref).to_int();
+        REQUIRE(re16_out[i] == max(-32768, min(32767, re_scaled)));
+        REQUIRE(im16_out[i] == max(-32768, min(32767, im_scaled)));
+    }
+
+    const vector<int32_t> raw(re_out);
+    cordic_c_scale_i32(rotator, re_out.data(), length);
+    for (size_t i = 0; i < length; i++) {
+        REQUIRE(re_out[i] == cordic_rom::scale_cordic(ap_int<cordic_rom::Out_W>(raw[i])).to_int());
+    }
+}
+
+TEST_CASE("C interface rotates float samples", "[C_API]") {
+    const cordic_c_rotator * rotator = cordic_c_find(16, 4, 7, 256, 2);
+    REQUIRE(rotator != nullptr);
+
+    const cordic_c_config config = cordic_c_get_config(rotator);
+
+    constexpr size_t length = 2048;
+    vector<float>    re(length), im(length);
+    for (size_t i = 0; i < length; i++) {
+        re[i] = float(5. * cos(0.01 * double(i)));
+        im[i] = float(-3. * sin(0.03 * double(i)));
+    }
+    const vector<float> re_in(re), im_in(im);
+
+    // In place.
+    cordic_c_rotate_f32(rotator, re.data(), im.data(), re.data(), im.data(), length, 0);
+
+    for (size_t i = 0; i < length; i++) {
+        const complex<double> expected = complex<double>(re_in[i], im_in[i]) * polar(1., rcr::rom_rotation(config.divider) / config.q * double(i % config.max_length));
+
+        REQUIRE(abs(complex<double>(re[i], im[i]) - expected) < double(1 << (config.out_i - 1)) * 2. / 100.);
+    }
+}
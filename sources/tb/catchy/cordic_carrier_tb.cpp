@@ -0,0 +1,107 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicCarrierLoop/CCordicCarrierLoop.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+typedef CCordicCarrierLoop<cordic>              carrier_loop;
+
+constexpr double turn = 4294967296.;
+
+// Carrier of `frequency` turns per sample and `phase` radians, modulated by `bits_per_symbol`
+// (0: none, 1: BPSK, 2: QPSK) random symbols, plus uniform noise.
+void synthetic_carrier(double frequency, double phase, unsigned bits_per_symbol, size_t length,
+                       vector<int64_t> & re, vector<int64_t> & im) {
+    const double amplitude = 0.6 * double(1 << (cordic::In_W - 1));
+
+    re.resize(length);
+    im.resize(length);
+
+    rcr::lcg rng;
+    for (size_t n = 0; n < length; n++) {
+        const uint64_t r      = rng.next();
+        const unsigned symbol = unsigned(r >> 60) & ((1U << bits_per_symbol) - 1U);
+        const double   noise  = (double(r >> 40 & 0xFFFF) / 65536. - 0.5) * 0.05;
+
+        const double          modulation = rcr::two_pi * double(symbol) / double(1U << bits_per_symbol);
+        const complex<double> x          = polar(amplitude * (1. + noise), rcr::two_pi * frequency * double(n) + phase + modulation);
+
+        re[n] = int64_t(lround(x.real()));
+        im[n] = int64_t(lround(x.imag()));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Vectoring CORDIC measures the phase", "[CARRIER]") {
+    constexpr double resolution = 1e-4;
+
+    for (double angle = -3.1; angle < 3.14; angle += 0.05) {
+        const complex<double> x = polar(20000., angle);
+
+        const int32_t phase = carrier_loop::vectoring(int64_t(x.real()), int64_t(x.imag()));
+        REQUIRE(abs(double(phase) / turn * rcr::two_pi - angle) < resolution * rcr::two_pi);
+    }
+}
+
+TEST_CASE("Carrier loops lock on synthetic data", "[CARRIER]") {
+    constexpr double frequency = 0.002;
+    constexpr size_t length    = 8000;
+    constexpr size_t settled   = 4000;
+    constexpr double max_phase = 3. / 360.; // In turns.
+
+    struct scenario {
+        carrier_mode mode;
+        unsigned     bits_per_symbol;
+    };
+    const scenario scenarios[] = {{carrier_mode::pll, 0}, {carrier_mode::costas_bpsk, 1}, {carrier_mode::costas_qpsk, 2}};
+
+    for (const scenario & s : scenarios) {
+        vector<int64_t> re_in, im_in;
+        synthetic_carrier(frequency, 1., s.bits_per_symbol, length, re_in, im_in);
+
+        carrier_loop    loop(s.mode, 0.01);
+        vector<int64_t> re_out(length), im_out(length);
+        loop.process(re_in.data(), im_in.data(), re_out.data(), im_out.data(), length);
+
+        REQUIRE(abs(loop.frequency_turns() - frequency) < 1e-4);
+
+        // Residual phase of the derotated symbols, modulo the constellation symmetry.
+        double mean_error = 0.;
+        for (size_t n = settled; n < length; n++) {
+            const uint32_t phase = uint32_t(carrier_loop::vectoring(re_out[n], im_out[n]));
+            mean_error += abs(double(int32_t(phase << s.bits_per_symbol) >> s.bits_per_symbol)) / turn;
+        }
+        mean_error /= double(length - settled);
+
+        REQUIRE(mean_error < max_phase);
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicFFT/CCordicFFT.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+template <class FFT>
+double fft_snr(const vector<int32_t> & re_in, const vector<int32_t> & im_in, int & exponent, vector<complex<double>> & spectrum) {
+    constexpr unsigned N = FFT::length;
+
+    vector<int32_t> re(re_in), im(im_in);
+    exponent = FFT::forward(re.data(), im.data());
+
+    double signal = 0., noise = 0.;
+    spectrum.resize(N);
+    for (unsigned k = 0; k < N; k++) {
+        complex<double> expected = 0.;
+        for (unsigned n = 0; n < N; n++) {
+            expected += complex<double>(re_in[n], im_in[n]) * polar(1., -rcr::two_pi * double((k * n) % N) / double(N));
+        }
+        spectrum[k] = complex<double>(re[k], im[k]) * ldexp(1., exponent);
+
+        signal += norm(expected);
+        noise += norm(spectrum[k] - expected);
+    }
+    return 10. * log10(signal / noise);
+}
+
+TEST_CASE("CORDIC-based FFT matches a double-precision DFT", "[FFT]") {
+    typedef CCordicRotateConstexpr<16, 1, 7, 64, 2> cordic_rom;
+
+    constexpr unsigned N = 128;
+
+    vector<int32_t> re(N), im(N);
+    for (unsigned n = 0; n < N; n++) {
+        re[n] = int32_t(12000. * cos(rcr::two_pi * 9. * n / N) + 3000. * sin(rcr::two_pi * 31. * n / N));
+        im[n] = int32_t(12000. * sin(rcr::two_pi * 9. * n / N) - 500. * cos(rcr::two_pi * 50. * n / N));
+    }
+
+    int                     exponent;
+    vector<complex<double>> spectrum;
+
+    SECTION("radix-2 - block floating point") {
+        const double snr = fft_snr<CCordicFFT<cordic_rom, N, fft_scaling::block_floating_point, 2>>(re, im, exponent, spectrum);
+        REQUIRE(snr > 30.);
+        REQUIRE(exponent <= int(CCordicFFT<cordic_rom, N>::log2_N));
+        REQUIRE(abs(spectrum[9]) == Approx(12000. * N).epsilon(0.02));
+    }
+
+    SECTION("radix-4 (with a radix-2 stage) - block floating point") {
+        const double snr = fft_snr<CCordicFFT<cordic_rom, N, fft_scaling::block_floating_point, 4>>(re, im, exponent, spectrum);
+        REQUIRE(snr > 30.);
+        REQUIRE(abs(spectrum[9]) == Approx(12000. * N).epsilon(0.02));
+    }
+
+    SECTION("radix-4 - per-stage scaling") {
+        const double snr = fft_snr<CCordicFFT<cordic_rom, 64, fft_scaling::per_stage, 4>>(re, im, exponent, spectrum);
+        REQUIRE(snr > 30.);
+        REQUIRE(exponent == 6);
+    }
+}
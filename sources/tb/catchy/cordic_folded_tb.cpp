@@ -0,0 +1,156 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateFolded/CCordicRotateFolded.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+
+struct folded_sample {
+    int64_t  re;
+    int64_t  im;
+    uint32_t counter;
+};
+
+vector<folded_sample> random_samples(size_t length) {
+    constexpr int64_t in_max = (int64_t(1) << (cordic::In_W - 1)) - 1;
+
+    vector<folded_sample> samples(length);
+    rcr::lcg              rng;
+    for (folded_sample & s : samples) {
+        s.re      = rng.uniform(-in_max, in_max);
+        s.im      = rng.uniform(-in_max, in_max);
+        s.counter = uint32_t(rng.next() >> 32) % cordic::max_length;
+    }
+    return samples;
+}
+
+// Feed every channel as fast as accepted, check the outputs against the unrolled datapath,
+// and return the cycle at which the first sample left the datapath.
+template <class Folded>
+uint64_t run_and_check(Folded & folded, const vector<folded_sample> & samples) {
+    const size_t per_channel = samples.size() / Folded::channels;
+
+    vector<size_t> pushed(Folded::channels, 0), popped(Folded::channels, 0);
+    uint64_t       first_output = 0;
+
+    size_t remaining = per_channel * Folded::channels;
+    while (remaining > 0) {
+        for (unsigned c = 0; c < Folded::channels; c++) {
+            if (pushed[c] < per_channel) {
+                const folded_sample & s = samples[c * per_channel + pushed[c]];
+                pushed[c] += folded.push(c, s.re, s.im, s.counter) ? 1 : 0;
+            }
+        }
+
+        folded.tick();
+
+        for (unsigned c = 0; c < Folded::channels; c++) {
+            int64_t re, im;
+            if (folded.pop(c, re, im)) {
+                const folded_sample & s = samples[c * per_channel + popped[c]++];
+
+                ap_int<cordic::Out_W> re_ref, im_ref;
+                cordic::cordic(s.re, s.im, s.counter, re_ref, im_ref);
+                REQUIRE(re == re_ref.to_int64());
+                REQUIRE(im == im_ref.to_int64());
+
+                first_output = first_output == 0 ? folded.stats().cycles : first_output;
+                remaining--;
+            }
+        }
+    }
+    return first_output;
+}
+
+} // namespace
+
+TEST_CASE("Folded rotators are bit-exact with the unrolled one", "[FOLDED]") {
+    const vector<folded_sample> samples = random_samples(3000);
+
+    SECTION("Untimed folded schedules") {
+        for (const folded_sample & s : samples) {
+            ap_int<cordic::Out_W> re_ref, im_ref;
+            cordic::cordic(s.re, s.im, s.counter, re_ref, im_ref);
+
+            int64_t re, im;
+            CCordicRotateFolded<cordic, 1>::cordic(s.re, s.im, s.counter, re, im);
+            REQUIRE(re == re_ref.to_int64());
+            REQUIRE(im == im_ref.to_int64());
+
+            CCordicRotateFolded<cordic, 4>::cordic(s.re, s.im, s.counter, re, im);
+            REQUIRE(re == re_ref.to_int64());
+            REQUIRE(im == im_ref.to_int64());
+        }
+    }
+
+    SECTION("Cycle model, one physical stage, one channel") {
+        typedef CCordicRotateFolded<cordic, 1, 1> folded_t;
+        folded_t                                  folded;
+
+        constexpr uint64_t latency = folded_t::latency;
+        constexpr unsigned ii      = folded_t::ii;
+        constexpr unsigned adders  = folded_t::adders;
+
+        REQUIRE(run_and_check(folded, samples) == latency);
+        REQUIRE(ii == 6);
+        REQUIRE(adders == 4);
+        REQUIRE(folded.throughput() == Approx(1. / ii).epsilon(0.01));
+    }
+
+    SECTION("Cycle model, 4 physical stages, 3 interleaved channels") {
+        typedef CCordicRotateFolded<cordic, 4, 3> folded_t;
+        folded_t                                  folded;
+
+        constexpr uint64_t latency    = folded_t::latency;
+        constexpr unsigned ii         = folded_t::ii;
+        constexpr unsigned channel_ii = folded_t::channel_ii;
+
+        REQUIRE(run_and_check(folded, samples) == latency);
+        REQUIRE(ii == 2);
+        REQUIRE(channel_ii == 6);
+        REQUIRE(folded.stats().stall_cycles == 0);
+        REQUIRE(folded.throughput() == Approx(1. / ii).epsilon(0.01));
+    }
+
+    SECTION("Unfolded, the cycle model has the unrolled adder count and latency") {
+        typedef CCordicRotateFolded<cordic, cordic::nb_stages> folded_t;
+        folded_t                                               folded;
+
+        constexpr uint64_t latency          = folded_t::latency;
+        constexpr unsigned ii               = folded_t::ii;
+        constexpr unsigned adders           = folded_t::adders;
+        constexpr unsigned unrolled_adders  = folded_t::unrolled_adders;
+        constexpr uint64_t unrolled_latency = folded_t::unrolled_latency;
+
+        REQUIRE(run_and_check(folded, samples) == latency);
+        REQUIRE(latency == unrolled_latency);
+        REQUIRE(ii == 1);
+        REQUIRE(adders == unrolled_adders);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRuntime/CCordicRotateRuntime.hpp"
+#include "RomGeneratorConst/RomGeneratorConst.hpp"
+#include "RomGeneratorML/RomGeneratorML.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+struct test_vector {
+    vector<complex<double>> x;
+    vector<uint64_t>        counters;
+};
+
+test_vector read_test_vector(unsigned n_lines, uint64_t max_length) {
+    test_vector tv;
+
+    ifstream INPUT("../data/input.dat");
+    for (unsigned iter = 0; iter < n_lines; iter++) {
+        char   sep;
+        double a, b, r;
+        INPUT >> a >> sep >> b >> sep >> r;
+        tv.x.emplace_back(a, b);
+        tv.counters.push_back((uint64_t(iter) * 2654435761U) % max_length);
+    }
+    return tv;
+}
+
+template <class Cordic, bool corrected>
+double max_error(const test_vector & tv) {
+    constexpr double in_scale  = double(Cordic::in_scale_factor);
+    constexpr double out_scale = double(Cordic::out_scale_factor);
+
+    double error = 0.;
+    for (size_t i = 0; i < tv.x.size(); i++) {
+        const complex<double> e = tv.x[i] * polar(1., Cordic::rotation / double(Cordic::q) * double(tv.counters[i]));
+
+        const ap_int<Cordic::In_W> re_in = int64_t(tv.x[i].real() * in_scale);
+        const ap_int<Cordic::In_W> im_in = int64_t(tv.x[i].imag() * in_scale);
+
+        ap_int<Cordic::Out_W> re_out, im_out;
+        if (corrected) {
+            Cordic::cordic_corrected(re_in, im_in, tv.counters[i], re_out, im_out);
+        } else {
+            Cordic::cordic(re_in, im_in, tv.counters[i], re_out, im_out);
+            re_out = Cordic::scale_cordic(re_out);
+            im_out = Cordic::scale_cordic(im_out);
+        }
+
+        error = max(error, abs(complex<double>(re_out.to_double(), im_out.to_double()) / out_scale - e));
+    }
+    return error;
+}
+
+} // namespace
+
+TEST_CASE("ROM gain correction lets few stages match the maximum stage count", "[GAIN]") {
+    typedef CCordicRotateConstexpr<16, 4, 3, 64, 2> cordic_3;
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic_6;
+    typedef CCordicRotateConstexpr<16, 4, 7, 64, 2> cordic_7;
+
+    const test_vector tv = read_test_vector(20000, cordic_3::max_length);
+
+    const double error_3           = max_error<cordic_3, false>(tv);
+    const double error_6           = max_error<cordic_6, false>(tv);
+    const double error_7           = max_error<cordic_7, false>(tv);
+    const double error_3_corrected = max_error<cordic_3, true>(tv);
+
+    REQUIRE(error_3_corrected < error_6);
+    REQUIRE(error_3_corrected < error_7);
+    REQUIRE(error_3_corrected < error_3 / 10.);
+}
+
+TEST_CASE("ML ROM gain correction compensates the measured gain", "[GAIN]") {
+    typedef CRomGeneratorML<16, 3, 64, 2> rom_ml;
+
+    const rom_ml               rom;
+    const CCordicRotateRuntime rotator(16, 4, 3, 64, 2, rom.rom);
+
+    constexpr unsigned gain_frac  = rom_ml::gain_frac;
+    constexpr uint64_t max_length = rom_ml::max_length;
+
+    const test_vector tv = read_test_vector(20000, max_length);
+
+    vector<int64_t> gains_re, gains_im;
+    rom.gains(gains_re, gains_im);
+    REQUIRE(gains_re.size() == max_length);
+
+    const double in_scale = double(rotator.in_scale_factor);
+
+    double error_corrected = 0., error_plain = 0.;
+    for (size_t i = 0; i < tv.x.size(); i++) {
+        const complex<double> e = tv.x[i] * polar(1., rotator.rotation / double(rotator.q) * double(tv.counters[i]));
+
+        int64_t re, im;
+        rotator.cordic(int64_t(tv.x[i].real() * in_scale), int64_t(tv.x[i].imag() * in_scale), tv.counters[i], re, im);
+
+        const int64_t gain_re = gains_re[tv.counters[i]];
+        const int64_t gain_im = gains_im[tv.counters[i]];
+        const int64_t half    = int64_t(1) << (gain_frac - 1);
+
+        const complex<double> corrected(double((re * gain_re - im * gain_im + half) >> gain_frac),
+                                        double((re * gain_im + im * gain_re + half) >> gain_frac));
+        const complex<double> plain(double(rotator.scale_cordic(re)), double(rotator.scale_cordic(im)));
+
+        error_corrected = max(error_corrected, abs(corrected / in_scale - e));
+        error_plain     = max(error_plain, abs(plain / in_scale - e));
+    }
+
+    REQUIRE(error_corrected < error_plain / 10.);
+}
+
+TEST_CASE("ROM header emitters optionally store the gain correction", "[GAIN]") {
+    const char filename[] = "cordic_rom_gain_test.hpp";
+
+    generate_rom_header_cst<12, 3, 16, 2>(filename, true);
+
+    ifstream    header(filename);
+    const string content((istreambuf_iterator<char>(header)), istreambuf_iterator<char>());
+    header.close();
+    remove(filename);
+
+    constexpr CRomGainConst<12, 3, 16, 2> gain {};
+    const string first_value = to_string(gain.gain_re[0]);
+
+    // 13 fractional bits, stored on 16 rather than 64.
+    constexpr bool narrow = is_same<CRomGainConst<12, 3, 16, 2>::gain_t, int16_t>::value;
+    REQUIRE(narrow);
+
+    REQUIRE(content.find("constexpr unsigned cst_12_3_16_2_gain_frac = 13;") != string::npos);
+    REQUIRE(content.find("constexpr int16_t cst_12_3_16_2_gain_re[64] = {") != string::npos);
+    REQUIRE(content.find("constexpr int16_t cst_12_3_16_2_gain_im[64] = {") != string::npos);
+    REQUIRE(content.find(first_value) != string::npos);
+}
@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateHybrid/CCordicRotateHybrid.hpp"
+
+#include <fstream>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+using Catch::Matchers::Floating::WithinAbsMatcher;
+
+template <class Cordic>
+double max_phase_error(unsigned counter_shift) {
+    constexpr unsigned n_lines  = 20000;
+    constexpr uint64_t length   = Cordic::max_length;
+
+    ifstream INPUT("../data/input.dat");
+
+    double max_error = 0.;
+    for (unsigned iter = 0; iter < n_lines; iter++) {
+        char   sep;
+        double a, b, r;
+        INPUT >> a >> sep >> b >> sep >> r;
+
+        // Walks the finest counter of the test, and keeps its MSBs for coarser rotators.
+        // Whatever the rotator, the counter always spans a whole turn.
+        const uint64_t fine_counter = (uint64_t(iter) * 2654435761U) % (length << counter_shift);
+        const uint64_t counter      = fine_counter >> counter_shift;
+
+        const complex<double> e = complex<double>(a, b) * exp(complex<double>(0., rcr::two_pi / double(length << counter_shift) * double(fine_counter)));
+
+        ap_int<Cordic::Out_W> re_out, im_out;
+        Cordic::cordic(ap_int<Cordic::In_W>(int64_t(a * double(Cordic::in_scale_factor))),
+                       ap_int<Cordic::In_W>(int64_t(b * double(Cordic::in_scale_factor))),
+                       counter,
+                       re_out, im_out);
+
+        const complex<double> o(Cordic::scale_cordic(re_out.to_double()) / Cordic::out_scale_factor,
+                                Cordic::scale_cordic(im_out.to_double()) / Cordic::out_scale_factor);
+
+        max_error = max(max_error, abs(o - e));
+    }
+    return max_error;
+}
+
+TEST_CASE("Hybrid rotator refines the coarse ROM resolution", "[HYBRID]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2>      coarse;
+    typedef CCordicRotateConstexpr<16, 4, 6, 1024, 2>    fine_rom;
+    typedef CCordicRotateHybrid<16, 4, 6, 64, 2, 4, 1> hybrid_1;
+    typedef CCordicRotateHybrid<16, 4, 6, 64, 2, 4, 2> hybrid_2;
+
+    constexpr unsigned hybrid_length = hybrid_1::max_length;
+    constexpr unsigned fine_length   = fine_rom::max_length;
+    REQUIRE(hybrid_length == fine_length);
+
+    const double coarse_error   = max_phase_error<coarse>(4);
+    const double fine_error     = max_phase_error<fine_rom>(0);
+    const double hybrid_1_error = max_phase_error<hybrid_1>(0);
+    const double hybrid_2_error = max_phase_error<hybrid_2>(0);
+
+    // The same ROM with a 16x finer resolution beats both the coarse rotator
+    // and a 16x larger ROM, thanks to the coarse angular error compensation.
+    REQUIRE(hybrid_1_error < coarse_error / 2.);
+    REQUIRE(hybrid_1_error < fine_error / 10.);
+    REQUIRE(hybrid_2_error <= hybrid_1_error);
+
+    const double abs_margin = double(1 << (hybrid_1::Out_I - 1)) * 2. / 100.;
+    REQUIRE_THAT(hybrid_2_error, WithinAbsMatcher(0., abs_margin));
+}
+
+TEST_CASE("Hybrid rotator resolves every fine step", "[HYBRID]") {
+    typedef CCordicRotateHybrid<16, 4, 6, 64, 2, 4, 2> hybrid;
+
+    constexpr uint64_t length    = hybrid::max_length;
+    constexpr double   fine_step = rcr::two_pi / double(length);
+
+    for (uint64_t counter = 0; counter < length; counter++) {
+        ap_int<hybrid::Out_W> re_out, im_out;
+        hybrid::cordic(ap_int<hybrid::In_W>(30000), ap_int<hybrid::In_W>(0), counter, re_out, im_out);
+
+        const double phase = atan2(im_out.to_double(), re_out.to_double());
+        const double error = remainder(phase - fine_step * double(counter), rcr::two_pi);
+
+        REQUIRE_THAT(error, WithinAbsMatcher(0., fine_step / 4.));
+    }
+}
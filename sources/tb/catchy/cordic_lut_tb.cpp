@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicEngineSelector/CCordicEngineSelector.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateLut/CCordicRotateLut.hpp"
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+TEST_CASE("Output table engine is bit-exact with the AP-Types CORDIC", "[LUT]") {
+    SECTION("W:6 - I:2 - Stages:5 - q:16 - divider:2 - compressed and raw tables") {
+        typedef CCordicRotateConstexpr<6, 2, 5, 16, 2>    cordic;
+        typedef CCordicRotateLut<6, 2, 5, 16, 2, true>  lut;
+        typedef CCordicRotateLut<6, 2, 5, 16, 2, false> raw_lut;
+
+        constexpr unsigned max_length = lut::max_length;
+        constexpr int64_t  in_min     = -(int64_t(1) << (lut::In_W - 1));
+        constexpr int64_t  in_max     = (int64_t(1) << (lut::In_W - 1)) - 1;
+
+        REQUIRE(raw_lut::nb_tables() == max_length);
+        REQUIRE(lut::nb_tables() < raw_lut::nb_tables());
+
+        for (unsigned counter = 0; counter < max_length; counter++) {
+            for (int64_t re = in_min; re <= in_max; re++) {
+                for (int64_t im = in_min; im <= in_max; im++) {
+                    ap_int<lut::Out_W> re_ref, im_ref, re_out, im_out, re_raw, im_raw;
+                    cordic::cordic(re, im, counter, re_ref, im_ref);
+                    lut::cordic(re, im, counter, re_out, im_out);
+                    raw_lut::cordic(re, im, counter, re_raw, im_raw);
+
+                    REQUIRE(re_out == re_ref);
+                    REQUIRE(im_out == im_ref);
+                    REQUIRE(re_raw == re_ref);
+                    REQUIRE(im_raw == im_ref);
+                }
+            }
+        }
+    }
+
+    SECTION("W:8 - I:3 - Stages:6 - q:64 - divider:2 - compressed tables") {
+        typedef CCordicRotateConstexpr<8, 3, 6, 64, 2> cordic;
+        typedef CCordicRotateLut<8, 3, 6, 64, 2>       lut;
+
+        constexpr int64_t in_min = -(int64_t(1) << (lut::In_W - 1));
+        constexpr int64_t in_max = (int64_t(1) << (lut::In_W - 1)) - 1;
+
+        REQUIRE(lut::table_bytes() == size_t(lut::nb_tables()) * lut::table_length * sizeof(lut::output_pair));
+
+        for (unsigned counter = 0; counter < lut::max_length; counter += 37) {
+            for (int64_t re = in_min; re <= in_max; re++) {
+                for (int64_t im = in_min; im <= in_max; im++) {
+                    ap_int<lut::Out_W> re_ref, im_ref, re_out, im_out;
+                    cordic::cordic(re, im, counter, re_ref, im_ref);
+                    lut::cordic(re, im, counter, re_out, im_out);
+
+                    REQUIRE(re_out == re_ref);
+                    REQUIRE(im_out == im_ref);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Engine selector accepts the output table engine", "[LUT]") {
+    typedef CCordicRotateConstexpr<8, 3, 6, 64, 2> cordic;
+    typedef CCordicRotateLut<8, 3, 6, 64, 2>       lut;
+
+    auto selection = CCordicEngineSelector<cordic, lut>::select(4096, 2);
+
+    REQUIRE(selection.reports.size() == 2);
+    REQUIRE(string(selection.reports[1].name) == "lut");
+    REQUIRE(selection.reports[0].max_error == selection.reports[1].max_error);
+}
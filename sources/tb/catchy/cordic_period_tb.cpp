@@ -0,0 +1,173 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicPhasor/CCordicPhasor.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+#include "CCordicRotateRuntime/CCordicRotateRuntime.hpp"
+#include "CCordicRotateTwiddle/CCordicRotateTwiddle.hpp"
+#include "RomGeneratorML/RomGeneratorML.hpp"
+#include "RomGeneratorRuntime/RomGeneratorRuntime.hpp"
+
+#include <complex>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+using Catch::Matchers::Floating::WithinAbsMatcher;
+
+TEST_CASE("Rational steps map to exact-period ROM parameters", "[PERIOD]") {
+    typedef rcr::rational_step<1, 1536>    step_1536;
+    typedef rcr::rational_step<2, 3070>    step_1535;
+    typedef rcr::rational_step<3008, 3001> step_3001;
+
+    constexpr uint32_t period_1536  = step_1536::period;
+    constexpr uint32_t q_1536       = step_1536::q;
+    constexpr uint32_t divider_1536 = step_1536::divider;
+    constexpr uint32_t period_1535  = step_1535::period;
+    constexpr uint32_t stride_1535  = step_1535::stride;
+    constexpr uint32_t period_3001  = step_3001::period;
+    constexpr uint32_t stride_3001  = step_3001::stride;
+
+    REQUIRE(period_1536 == 1536);
+    REQUIRE(q_1536 == 1536);
+    REQUIRE(divider_1536 == 0);
+    REQUIRE(period_1535 == 1535);
+    REQUIRE(stride_1535 == 1);
+    REQUIRE(period_3001 == 3001);
+    REQUIRE(stride_3001 == 7);
+
+    constexpr unsigned length_1535 = CCordicRotateConstexpr<16, 4, 6, step_1535::q, step_1535::divider>::max_length;
+    constexpr unsigned addr_1535   = CCordicRotateConstexpr<16, 4, 6, step_1535::q, step_1535::divider>::addr_length;
+    constexpr unsigned length_3000 = CCordicRotateConstexpr<16, 4, 6, 500, 3>::max_length;
+    constexpr double   step_3000   = CCordicRotateConstexpr<16, 4, 6, 500, 3>::rotation / 500.;
+    constexpr double   full_3000   = CCordicRotateConstexpr<16, 4, 6, 3000, 0>::rotation / 3000.;
+
+    REQUIRE(length_1535 == 1535);
+    REQUIRE(addr_1535 == 11);
+    REQUIRE(length_3000 == 3000);
+    REQUIRE_THAT(step_3000, WithinAbsMatcher(full_3000, 1e-15));
+}
+
+TEST_CASE("Non-power-of-two periods rotate accurately across the wraparound", "[PERIOD]") {
+    typedef rcr::rational_step<7, 3001>                               step;
+    typedef CCordicRotateConstexpr<16, 4, 6, step::q, step::divider> cordic;
+    typedef CCordicRotateTwiddle<16, 4, 6, step::q, step::divider>   twiddle;
+
+    constexpr unsigned max_length = cordic::max_length;
+    constexpr unsigned stride     = step::stride;
+    constexpr double   in_scale   = double(cordic::in_scale_factor);
+    constexpr double   out_scale  = double(cordic::out_scale_factor);
+
+    constexpr double abs_margin = double(1 << (cordic::Out_I - 1)) * 2. / 100.;
+
+    const complex<double> x(2.5, -1.25);
+
+    // Three periods, wrapping with a compare-and-subtract rather than a mask.
+    uint32_t counter = 0;
+    for (unsigned n = 0; n < 3 * max_length; n++) {
+        const complex<double> e = x * polar(1., rcr::two_pi * double(stride) * double(n) / double(max_length));
+
+        ap_int<cordic::Out_W> re_out, im_out;
+        cordic::cordic(ap_int<16>(int64_t(x.real() * in_scale)), ap_int<16>(int64_t(x.imag() * in_scale)), counter, re_out, im_out);
+
+        REQUIRE_THAT(cordic::scale_cordic(re_out.to_double()) / out_scale, WithinAbsMatcher(e.real(), abs_margin));
+        REQUIRE_THAT(cordic::scale_cordic(im_out.to_double()) / out_scale, WithinAbsMatcher(e.imag(), abs_margin));
+
+        // Same grid, from the twiddle table.
+        ap_int<twiddle::Out_W> re_tw, im_tw;
+        twiddle::cordic(ap_int<16>(int64_t(x.real() * in_scale)), ap_int<16>(int64_t(x.imag() * in_scale)), counter, re_tw, im_tw);
+
+        REQUIRE_THAT(twiddle::scale_cordic(re_tw.to_double()) / out_scale, WithinAbsMatcher(e.real(), abs_margin));
+        REQUIRE_THAT(twiddle::scale_cordic(im_tw.to_double()) / out_scale, WithinAbsMatcher(e.imag(), abs_margin));
+
+        counter += stride;
+        counter = counter >= max_length ? counter - max_length : counter;
+    }
+
+    SECTION("Block rotation and phasor addresses wrap on the exact period") {
+        const CCordicRotatorInstance<cordic> rotator;
+        REQUIRE(rotator.max_length == 3001);
+
+        constexpr size_t length = 64;
+
+        vector<int32_t> re_in(length), im_in(length), re_out(length), im_out(length);
+        for (size_t i = 0; i < length; i++) {
+            re_in[i] = int32_t((i * 37) % 4096) - 2048;
+            im_in[i] = int32_t((i * 91) % 4096) - 2048;
+        }
+
+        rotator.cordic(re_in.data(), im_in.data(), max_length - 20, re_out.data(), im_out.data(), length);
+
+        for (size_t i = 0; i < length; i++) {
+            ap_int<cordic::Out_W> re_ref, im_ref;
+            cordic::cordic(ap_int<16>(re_in[i]), ap_int<16>(im_in[i]), (max_length - 20 + i) % max_length, re_ref, im_ref);
+            REQUIRE(re_out[i] == re_ref.to_int());
+            REQUIRE(im_out[i] == im_ref.to_int());
+        }
+
+        typedef CCordicPhasor<cordic> phasor;
+        REQUIRE(phasor::compose(max_length - 1, 3) == 2);
+        REQUIRE(phasor::inverse(7) == max_length - 7);
+    }
+}
+
+TEST_CASE("ML and runtime generators build exact-period ROMs", "[PERIOD]") {
+    // 2 * pi / 1536, with a non-power-of-two divider.
+    constexpr unsigned length_1536 = CRomGeneratorML<12, 5, 256, 3>::max_length;
+
+    REQUIRE(length_1536 == 1536);
+    REQUIRE(CRomGeneratorRuntime(rcr::generator_type::cst, 12, 5, 256, 3).max_length == 1536);
+
+    // 2 * pi / 1535: an odd period, q addresses spanning the full turn.
+    const CRomGeneratorML<12, 5, 1535, 0> ml;
+    const CRomGeneratorRuntime            runtime(rcr::generator_type::ml, 12, 5, 1535, 0);
+    const CRomGeneratorRuntime            cst(rcr::generator_type::cst, 12, 5, 1535, 0);
+
+    constexpr unsigned ml_length = CRomGeneratorML<12, 5, 1535, 0>::max_length;
+
+    REQUIRE(ml_length == 1535);
+    REQUIRE(runtime.max_length == 1535);
+    REQUIRE(runtime.addr_length == 11);
+    REQUIRE(CRomGeneratorRuntime::valid_parameters(12, 5, 1535, 0));
+
+    for (unsigned n = 0; n < ml_length; n++) {
+        REQUIRE(runtime.rom[n] == ml.rom[n]);
+    }
+
+    const CCordicRotateRuntime rotator(12, 4, 5, 1535, 0, runtime.rom.data());
+    const CCordicRotateRuntime rotator_cst(12, 4, 5, 1535, 0, cst.rom.data());
+    REQUIRE(rotator.max_length == 1535);
+
+    // A 5-stage CORDIC leaves up to atan(2^-4) of residual angle, plus the truncations.
+    const double          margin = rcr::atan_values[4] + 0.01;
+    const complex<double> x(1500., -700.);
+    for (unsigned n = 0; n < rotator.max_length; n++) {
+        const complex<double> e = x * polar(1., rcr::two_pi / 1535. * double(n)) / rcr::kn_values[4];
+
+        int64_t re_out, im_out;
+        rotator.cordic(int64_t(x.real()), int64_t(x.imag()), n, re_out, im_out);
+        REQUIRE(abs(complex<double>(double(re_out), double(im_out)) - e) < margin * abs(e));
+
+        rotator_cst.cordic(int64_t(x.real()), int64_t(x.imag()), n, re_out, im_out);
+        REQUIRE(abs(complex<double>(double(re_out), double(im_out)) - e) < margin * abs(e));
+    }
+}
@@ -0,0 +1,121 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicPhasor/CCordicPhasor.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+typedef CCordicPhasor<cordic>                   phasor;
+
+// Chained passes: each output is gain-compensated and brought back to the input format.
+ap_int<cordic::In_W> chain_step(const ap_int<cordic::In_W> & re, const ap_int<cordic::In_W> & im, uint64_t counter,
+                                ap_int<cordic::In_W> & im_next) {
+    ap_int<cordic::Out_W> re_out, im_out;
+    cordic::cordic(re, im, counter, re_out, im_out);
+    im_next = cordic::scale_cordic(im_out).to_int64();
+    return cordic::scale_cordic(re_out).to_int64();
+}
+
+} // namespace
+
+TEST_CASE("Pending rotations compose as a ROM address sum", "[PHASOR]") {
+    constexpr unsigned max_length = cordic::max_length;
+
+    REQUIRE(phasor::compose(max_length - 1, 3) == 2);
+    REQUIRE(phasor::compose(5, max_length) == 5);
+    REQUIRE(phasor::inverse(0) == 0);
+    REQUIRE(phasor::compose(17, phasor::inverse(17)) == 0);
+
+    rcr::lcg rng;
+    for (unsigned i = 0; i < 1000; i++) {
+        const uint64_t r  = rng.next();
+        const int64_t re  = int64_t((r >> 11) % 16384) - 8192;
+        const int64_t im  = int64_t((r >> 35) % 16384) - 8192;
+        const uint64_t a  = (r >> 7) % max_length;
+        const uint64_t b  = (r >> 17) % max_length;
+        const uint64_t c  = (r >> 27) % max_length;
+
+        phasor x(re, im);
+        x.rotate(a).rotate(b).rotate_back(c);
+        REQUIRE(x.pending_rotations() == 3);
+        REQUIRE(x.address() == (a + b + max_length - c) % max_length);
+
+        ap_int<cordic::Out_W> re_out, im_out, re_ref, im_ref;
+        x.evaluate(re_out, im_out);
+        cordic::cordic(re, im, (a + b + max_length - c) % max_length, re_ref, im_ref);
+        REQUIRE(re_out == re_ref);
+        REQUIRE(im_out == im_ref);
+    }
+}
+
+TEST_CASE("One composed pass is more accurate than chained passes", "[PHASOR]") {
+    constexpr unsigned max_length = cordic::max_length;
+    constexpr size_t   length     = 4096;
+
+    const double in_scale = double(cordic::in_scale_factor);
+    const double step     = rcr::two_pi / double(max_length);
+
+    // Phase offset, frequency ramp and per-symbol correction.
+    vector<uint32_t> offset(length, 11), ramp(length), correction(length);
+    vector<int32_t>  re_in(length), im_in(length), re_out(length), im_out(length);
+    for (size_t i = 0; i < length; i++) {
+        ramp[i]       = uint32_t((3 * i) % max_length);
+        correction[i] = uint32_t(phasor::inverse((i / 16) % 5));
+        re_in[i]      = int32_t(8000. * cos(0.01 * double(i)));
+        im_in[i]      = int32_t(8000. * sin(0.013 * double(i)));
+    }
+
+    const uint32_t * counters[] = {offset.data(), ramp.data(), correction.data()};
+    phasor::evaluate(re_in.data(), im_in.data(), counters, 3, re_out.data(), im_out.data(), length);
+
+    double composed_noise = 0., chained_noise = 0., signal = 0.;
+    for (size_t i = 0; i < length; i++) {
+        const uint64_t        sum      = (uint64_t(offset[i]) + ramp[i] + correction[i]) % max_length;
+        const complex<double> expected = complex<double>(re_in[i], im_in[i]) / in_scale * polar(1., step * double(sum));
+
+        const complex<double> composed(cordic::scale_cordic(double(re_out[i])) / in_scale,
+                                       cordic::scale_cordic(double(im_out[i])) / in_scale);
+
+        ap_int<cordic::In_W> re = re_in[i], im = im_in[i];
+        for (const uint32_t * counter : counters) {
+            ap_int<cordic::In_W> im_next;
+            re = chain_step(re, im, counter[i], im_next);
+            im = im_next;
+        }
+        const complex<double> chained(re.to_double() / in_scale, im.to_double() / in_scale);
+
+        signal += norm(expected);
+        composed_noise += norm(composed - expected);
+        chained_noise += norm(chained - expected);
+    }
+
+    REQUIRE(composed_noise < chained_noise / 2.);
+    REQUIRE(10. * log10(signal / composed_noise) > 30.);
+}
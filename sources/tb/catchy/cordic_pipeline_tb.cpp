@@ -0,0 +1,179 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicPipeline/CCordicPipeline.hpp"
+#include "CCordicPipeline/CSpscRing.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+TEST_CASE("SPSC ring transfers elements in order and reports fullness", "[PIPELINE]") {
+    CSpscRing<uint64_t, 8> ring;
+
+    for (unsigned i = 0; i < 8; i++) {
+        uint64_t * slot = ring.write_slot();
+        REQUIRE(slot != nullptr);
+        *slot = i;
+        ring.commit();
+    }
+    REQUIRE(ring.write_slot() == nullptr);
+    REQUIRE(ring.size() == 8);
+
+    REQUIRE(*ring.read_slot() == 0);
+    ring.release();
+    REQUIRE(ring.write_slot() != nullptr);
+
+    while (ring.read_slot() != nullptr) {
+        ring.release();
+    }
+    REQUIRE(ring.size() == 0);
+
+    constexpr uint64_t n = 200000;
+
+    thread producer([&ring]() {
+        for (uint64_t i = 0; i < n; i++) {
+            uint64_t * slot;
+            while ((slot = ring.write_slot()) == nullptr) {
+                this_thread::yield();
+            }
+            *slot = i;
+            ring.commit();
+        }
+    });
+
+    bool in_order = true;
+    for (uint64_t i = 0; i < n; i++) {
+        const uint64_t * slot;
+        while ((slot = ring.read_slot()) == nullptr) {
+            this_thread::yield();
+        }
+        in_order = in_order && *slot == i;
+        ring.release();
+    }
+    producer.join();
+
+    REQUIRE(in_order);
+}
+
+TEST_CASE("Streaming pipeline is bit-exact with the rotator and keeps the order", "[PIPELINE]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2>  cordic_rom;
+    typedef CCordicPipeline<cordic_rom, 100, 4>      pipeline_t;
+
+    constexpr size_t   length     = 123457;
+    constexpr uint32_t max_length = cordic_rom::max_length;
+
+    vector<int32_t> re(length), im(length);
+    for (size_t i = 0; i < length; i++) {
+        re[i] = int32_t((int64_t(i) * 7919) % 65535 - 32767);
+        im[i] = int32_t((int64_t(i) * 104729) % 65535 - 32767);
+    }
+
+    size_t          read = 0;
+    vector<int32_t> re_out, im_out;
+    re_out.reserve(length);
+    im_out.reserve(length);
+
+    // Irregular reads, to exercise partial blocks.
+    auto source = [&](int32_t * re_b, int32_t * im_b, size_t max_n) -> size_t {
+        const size_t n = min(length - read, (read % 3 == 0) ? max_n : max_n / 3 + 1);
+        copy(re.begin() + read, re.begin() + read + n, re_b);
+        copy(im.begin() + read, im.begin() + read + n, im_b);
+        read += n;
+        return n;
+    };
+    auto sink = [&](const int32_t * re_b, const int32_t * im_b, size_t n) {
+        re_out.insert(re_out.end(), re_b, re_b + n);
+        im_out.insert(im_out.end(), im_b, im_b + n);
+    };
+
+    pipeline_t pipeline(3, source, sink, 17);
+    pipeline.start();
+    pipeline.wait();
+
+    REQUIRE(re_out.size() == length);
+
+    bool exact = true;
+    for (size_t i = 0; i < length; i++) {
+        ap_int<cordic_rom::Out_W> re_ref, im_ref;
+        cordic_rom::cordic(re[i], im[i], (17 + i) % max_length, re_ref, im_ref);
+        exact = exact && re_out[i] == re_ref.to_int() && im_out[i] == im_ref.to_int();
+    }
+    REQUIRE(exact);
+
+    const pipeline_stats stats = pipeline.stats();
+    REQUIRE(stats.samples == length);
+    REQUIRE(stats.max_queue_depth <= size_t(3 * 2 * pipeline_t::depth));
+    REQUIRE(stats.max_latency_ns >= stats.mean_latency_ns);
+    REQUIRE(pipeline.queue_depth() <= 3); // Unread end marks
+}
+
+TEST_CASE("Streaming pipeline applies backpressure to a fast source", "[PIPELINE]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic_rom;
+    typedef CCordicPipeline<cordic_rom, 64, 2>      pipeline_t;
+
+    size_t blocks_read = 0;
+    auto   source      = [&](int32_t * re_b, int32_t * im_b, size_t max_n) -> size_t {
+        if (blocks_read++ == 200) {
+            return 0;
+        }
+        fill(re_b, re_b + max_n, 1000);
+        fill(im_b, im_b + max_n, -1000);
+        return max_n;
+    };
+    auto sink = [](const int32_t *, const int32_t *, size_t) {
+        this_thread::sleep_for(chrono::microseconds(200));
+    };
+
+    pipeline_t pipeline(2, source, sink);
+    pipeline.start();
+    pipeline.wait();
+
+    const pipeline_stats stats = pipeline.stats();
+    REQUIRE(stats.blocks == 200);
+    REQUIRE(stats.backpressure_waits > 0);
+    REQUIRE(stats.max_queue_depth <= size_t(2 * 2 * pipeline_t::depth));
+}
+
+TEST_CASE("Streaming pipeline can be stopped", "[PIPELINE]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic_rom;
+
+    atomic<uint64_t> delivered(0);
+    auto             source = [](int32_t * re_b, int32_t * im_b, size_t max_n) -> size_t {
+        fill(re_b, re_b + max_n, 1);
+        fill(im_b, im_b + max_n, 2);
+        return max_n;
+    };
+    auto sink = [&delivered](const int32_t *, const int32_t *, size_t n) {
+        delivered += n;
+    };
+
+    CCordicPipeline<cordic_rom> pipeline(2, source, sink);
+    pipeline.start();
+    this_thread::sleep_for(chrono::milliseconds(20));
+    pipeline.stop();
+    pipeline.wait();
+
+    REQUIRE(delivered.load() > 0);
+    REQUIRE(pipeline.stats().samples == delivered.load());
+}
@@ -0,0 +1,139 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicProfiler/CCordicProfiler.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+
+void rotate_samples(unsigned length) {
+    for (unsigned i = 0; i < length; i++) {
+        ap_int<cordic::Out_W> re_out, im_out;
+        cordic::cordic(ap_int<cordic::In_W>(int64_t(i % 1000)), ap_int<cordic::In_W>(-int64_t(i % 700)), i % cordic::max_length, re_out, im_out);
+    }
+}
+
+} // namespace
+
+#if defined(CORDIC_PROFILING)
+
+namespace {
+
+profile_report find_site(const char * name) {
+    for (const profile_report & r : CCordicProfiler::snapshot()) {
+        if (strcmp(r.name, name) == 0) {
+            return r;
+        }
+    }
+    FAIL("No profiled call site " << name);
+    return profile_report();
+}
+
+} // namespace
+
+TEST_CASE("Profiled entry points record their calls and cycles", "[PROFILE]") {
+    CCordicProfiler::reset();
+    CCordicProfiler::set_sampling(1);
+
+    rotate_samples(1000);
+
+    const profile_report single = find_site("CCordicRotateConstexpr::cordic");
+    REQUIRE(single.calls == 1000);
+    REQUIRE(single.timed_calls == 1000);
+    REQUIRE(single.samples == 1000);
+    REQUIRE(single.cycles > 0);
+
+    uint64_t histogram_calls = 0;
+    for (uint64_t calls : single.histogram) {
+        histogram_calls += calls;
+    }
+    REQUIRE(histogram_calls == 1000);
+
+    // Batch entry points count their samples, and the nested calls are still counted.
+    const CCordicRotatorInstance<cordic> rotator;
+    vector<int32_t>                      re(4096, 1000), im(4096, -1000);
+    rotator.cordic(re.data(), im.data(), 3, re.data(), im.data(), re.size());
+
+    const profile_report batch = find_site("CCordicRotator::cordic(counter)");
+    REQUIRE(batch.calls == 1);
+    REQUIRE(batch.samples == 4096);
+    REQUIRE(find_site("CCordicRotateConstexpr::cordic").calls == 1000 + 4096);
+
+    FILE * report = tmpfile();
+    REQUIRE(report != nullptr);
+    CCordicProfiler::dump(report);
+    rewind(report);
+
+    vector<char> text(4096, '\0');
+    const size_t read = fread(text.data(), 1, text.size() - 1, report);
+    fclose(report);
+    REQUIRE(read > 0);
+    REQUIRE(strstr(text.data(), "cycles/call") != nullptr);
+    REQUIRE(strstr(text.data(), "CCordicRotator::cordic(counter)") != nullptr);
+}
+
+TEST_CASE("Profiling samples one call in N, and aggregates every thread", "[PROFILE]") {
+    CCordicProfiler::reset();
+    CCordicProfiler::set_sampling(10);
+
+    thread worker(rotate_samples, 2000);
+    worker.join();
+    rotate_samples(1000);
+
+    const profile_report single = find_site("CCordicRotateConstexpr::cordic");
+    REQUIRE(single.calls == 3000);
+    REQUIRE(single.timed_calls == 300);
+
+    // Not every kernel lets user space count, the report tells whether it did.
+    if (CCordicProfiler::enable_counters(true)) {
+        rotate_samples(1000);
+        const profile_report counted = find_site("CCordicRotateConstexpr::cordic");
+        REQUIRE(counted.has_counters);
+        REQUIRE(counted.counted_calls > 0);
+        REQUIRE(counted.instructions > counted.counted_calls);
+    }
+    CCordicProfiler::enable_counters(false);
+    CCordicProfiler::set_sampling(1);
+}
+
+#else
+
+TEST_CASE("Compiled-out profiling records nothing", "[PROFILE]") {
+    constexpr bool enabled = CCordicProfiler::enabled;
+
+    rotate_samples(1000);
+
+    REQUIRE_FALSE(enabled);
+    REQUIRE_FALSE(CCordicProfiler::enable_counters(true));
+    REQUIRE(CCordicProfiler::snapshot().empty());
+}
+
+#endif
@@ -0,0 +1,363 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateRom/CCordicRotateRom_ml_16_6_64_2.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <fstream>
+#include <iostream>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+using Catch::Matchers::Floating::WithinAbsMatcher;
+
+typedef CCordicRotateRom<4, ml, 16, 6, 64, 2> cordic_rom;
+
+#if defined(SOFTWARE)
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) works with C-Types", "[CORDIC]") {
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - div:2") {
+        static constexpr cordic_rom cordic {};
+
+        string input_fn = "../data/input.dat";
+
+        constexpr unsigned n_lines = 100000;
+
+        vector<complex<double>> values_in(n_lines);
+        vector<complex<double>> values_out(n_lines);
+
+        vector<complex<double>> results(n_lines);
+
+        ifstream INPUT(input_fn);
+
+        // Init test vector
+        for (unsigned i = 0; i < n_lines; i++) {
+            double a, b, r;
+            INPUT >> a >> b >> r;
+
+            const complex<double> c {a, b};
+            values_in[i] = c;
+
+            constexpr double rotation = cordic_rom::rotation;
+            constexpr double q        = cordic_rom::q;
+
+            const complex<double> e = exp(complex<double>(0., rotation / q * (i & 255)));
+            results[i]              = c * e;
+        }
+
+        INPUT.close();
+
+        constexpr double abs_margin = double(1 << cordic.Out_I) * 2. / 100.;
+
+        // Executing the CORDIC
+        for (unsigned iter = 0; iter < n_lines; iter++) {
+            // Execute
+
+            values_out[iter] = cordic_rom::cordic(values_in[iter], (iter & 255));
+
+            REQUIRE_THAT(values_out[iter].real(), WithinAbsMatcher(results[iter].real(), abs_margin));
+            REQUIRE_THAT(values_out[iter].imag(), WithinAbsMatcher(results[iter].imag(), abs_margin));
+        }
+    }
+}
+#endif
+
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) works with AP-Types", "[CORDIC]") {
+    constexpr unsigned n_lines = 100000;
+
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - div:2") {
+
+        static constexpr cordic_rom cordic {};
+
+        string input_fn = "../data/input.dat";
+
+        constexpr double   rotation = cordic_rom::rotation;
+        constexpr double   q        = cordic_rom::q;
+        constexpr uint64_t cnt_mask = 0xFF; // Value dependant of the way the ROM is initialized
+
+        constexpr unsigned Out_W = cordic_rom::Out_W;
+        constexpr unsigned In_W  = cordic_rom::In_W;
+
+        vector<ap_int<In_W>>  values_re_in(n_lines);
+        vector<ap_int<In_W>>  values_im_in(n_lines);
+        vector<ap_int<Out_W>> values_re_out(n_lines);
+        vector<ap_int<Out_W>> values_im_out(n_lines);
+
+        vector<double> results_re(n_lines);
+        vector<double> results_im(n_lines);
+
+        FILE * INPUT = fopen(input_fn.c_str(), "r");
+
+        // Init test vector
+        for (unsigned i = 0; i < n_lines; i++) {
+            double a, b, r;
+            fscanf(INPUT, "%lf,%lf,%lf\n", &a, &b, &r);
+
+            const complex<double> c {a, b};
+            values_re_in[i] = int64_t(a * double(cordic_rom::in_scale_factor));
+            values_im_in[i] = int64_t(b * double(cordic_rom::in_scale_factor));
+
+            const complex<double> e = c * exp(complex<double>(0., rotation / q * (i & cnt_mask)));
+            results_re[i]           = e.real();
+            results_im[i]           = e.imag();
+        }
+
+        fclose(INPUT);
+
+        constexpr double abs_margin = double(1 << cordic.Out_I) * 2. / 100.;
+
+        // Executing the CORDIC
+        for (unsigned iter = 0; iter < n_lines; iter++) {
+            // Execute
+            const uint8_t counter = uint8_t(iter & cnt_mask);
+
+            cordic_rom::cordic(
+                values_re_in[iter], values_im_in[iter],
+                counter,
+                values_re_out[iter], values_im_out[iter]);
+
+            REQUIRE_THAT(values_re_out[iter].to_double() * 5. / 8. / cordic_rom::out_scale_factor, WithinAbsMatcher(results_re[iter], abs_margin));
+            REQUIRE_THAT(values_im_out[iter].to_double() * 5. / 8. / cordic_rom::out_scale_factor, WithinAbsMatcher(results_im[iter], abs_margin));
+        }
+    }
+
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - div:2 - internal scaling") {
+        static constexpr cordic_rom cordic {};
+
+        string input_fn = "../data/input.dat";
+
+        constexpr double   rotation = cordic_rom::rotation;
+        constexpr double   q        = cordic_rom::q;
+        constexpr uint64_t cnt_mask = 0xFF; // Value dependant of the way the ROM is initialized
+
+        constexpr unsigned Out_W = cordic_rom::Out_W;
+        constexpr unsigned In_W  = cordic_rom::In_W;
+
+        vector<ap_int<In_W>>  values_re_in(n_lines);
+        vector<ap_int<In_W>>  values_im_in(n_lines);
+        vector<ap_int<Out_W>> values_re_out(n_lines);
+        vector<ap_int<Out_W>> values_im_out(n_lines);
+
+        vector<double> results_re(n_lines);
+        vector<double> results_im(n_lines);
+
+        FILE * INPUT = fopen(input_fn.c_str(), "r");
+
+        // Init test vector
+        for (unsigned i = 0; i < n_lines; i++) {
+            double a, b, r;
+            fscanf(INPUT, "%lf,%lf,%lf\n", &a, &b, &r);
+
+            const complex<double> c {a, b};
+            values_re_in[i] = int64_t(a * double(cordic_rom::in_scale_factor));
+            values_im_in[i] = int64_t(b * double(cordic_rom::in_scale_factor));
+
+            const complex<double> e = c * exp(complex<double>(0., rotation / q * (i & cnt_mask)));
+            results_re[i]           = e.real();
+            results_im[i]           = e.imag();
+        }
+
+        fclose(INPUT);
+
+        constexpr double abs_margin = double(1 << cordic.Out_I) * 2. / 100.;
+
+        // Executing the CORDIC
+        for (unsigned iter = 0; iter < n_lines; iter++) {
+            // Execute
+            const uint8_t counter = uint8_t(iter & cnt_mask);
+
+            cordic_rom::cordic(
+                values_re_in[iter], values_im_in[iter],
+                counter,
+                values_re_out[iter], values_im_out[iter]);
+
+            REQUIRE_THAT(cordic_rom::scale_cordic(values_re_out[iter]).to_double() / cordic_rom::out_scale_factor,
+                         WithinAbsMatcher(results_re[iter],
+                                          abs_margin));
+            REQUIRE_THAT(cordic_rom::scale_cordic(values_im_out[iter]).to_double() / cordic_rom::out_scale_factor,
+                         WithinAbsMatcher(results_im[iter],
+                                          abs_margin));
+        }
+    }
+}
+
+#if 0
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) gain correction is more accurate than scaling", "[CORDIC]") {
+    constexpr unsigned n_lines = 20000;
+
+    constexpr double   rotation   = cordic_rom::rotation;
+    constexpr double   q          = cordic_rom::q;
+    constexpr double   in_scale   = double(cordic_rom::in_scale_factor);
+    constexpr double   out_scale  = double(cordic_rom::out_scale_factor);
+    constexpr uint64_t max_length = cordic_rom::max_length;
+
+    FILE * INPUT = fopen("../data/input.dat", "r");
+
+    double error_scaled = 0., error_corrected = 0.;
+    for (unsigned iter = 0; iter < n_lines; iter++) {
+        double a, b, r;
+        fscanf(INPUT, "%lf,%lf,%lf\n", &a, &b, &r);
+
+        const uint64_t counter = iter % max_length;
+
+        const complex<double> e = complex<double>(a, b) * exp(complex<double>(0., rotation / q * double(counter)));
+
+        const ap_int<cordic_rom::In_W> re_in = int64_t(a * in_scale);
+        const ap_int<cordic_rom::In_W> im_in = int64_t(b * in_scale);
+
+        ap_int<cordic_rom::Out_W> re_out, im_out;
+        cordic_rom::cordic(re_in, im_in, counter, re_out, im_out);
+        error_scaled = max(error_scaled, abs(complex<double>(cordic_rom::scale_cordic(re_out).to_double(), cordic_rom::scale_cordic(im_out).to_double()) / out_scale - e));
+
+        cordic_rom::cordic_corrected(re_in, im_in, counter, re_out, im_out);
+        error_corrected = max(error_corrected, abs(complex<double>(re_out.to_double(), im_out.to_double()) / out_scale - e));
+    }
+
+    fclose(INPUT);
+
+    REQUIRE(error_corrected < error_scaled);
+}
+#endif
+
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) dual rotation matches two single rotations", "[CORDIC]") {
+    constexpr unsigned In_W       = cordic_rom::In_W;
+    constexpr unsigned Out_W      = cordic_rom::Out_W;
+    constexpr uint64_t max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    for (uint64_t counter = 0; counter < max_length; counter++) {
+        for (int64_t re = -in_max - 1; re <= in_max; re += in_max / 7) {
+            // -2^(In_W - 1) is its own opposite on In_W bits, in both inputs.
+            for (const int64_t im : {(re * 7 + int64_t(counter) * 131) % in_max, -in_max - 1}) {
+                ap_int<Out_W> re_pos, im_pos, re_neg, im_neg;
+                cordic_rom::cordic_dual(re, im, counter, re_pos, im_pos, re_neg, im_neg);
+
+                ap_int<Out_W> re_ref, im_ref;
+                cordic_rom::cordic(re, im, counter, re_ref, im_ref);
+                REQUIRE(re_pos == re_ref);
+                REQUIRE(im_pos == im_ref);
+
+                cordic_rom::cordic(re, -im, counter, re_ref, im_ref);
+                REQUIRE(re_neg == re_ref);
+                REQUIRE(im_neg == ap_int<Out_W>(-im_ref));
+            }
+        }
+    }
+}
+
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) early termination", "[CORDIC]") {
+    constexpr unsigned In_W       = cordic_rom::In_W;
+    constexpr unsigned Out_W      = cordic_rom::Out_W;
+    constexpr unsigned nb_stages  = cordic_rom::nb_stages;
+    constexpr uint64_t max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    const double out_scale = double(cordic_rom::out_scale_factor);
+
+    double previous_error = INFINITY;
+    for (unsigned stages = 1; stages <= nb_stages; stages++) {
+        double max_error = 0.;
+        for (uint64_t counter = 0; counter < max_length; counter++) {
+            for (int64_t re = -in_max; re <= in_max; re += in_max / 7) {
+                const int64_t im = (re * 7 + int64_t(counter) * 131) % in_max;
+
+                ap_int<Out_W> re_out, im_out;
+                cordic_rom::cordic(re, im, counter, stages, re_out, im_out);
+
+                if (stages == nb_stages) {
+                    ap_int<Out_W> re_ref, im_ref;
+                    cordic_rom::cordic(re, im, counter, re_ref, im_ref);
+                    REQUIRE(re_out == re_ref);
+                    REQUIRE(im_out == im_ref);
+
+                    // Out-of-range stage counts are clamped to [1, nb_stages].
+                    cordic_rom::cordic(re, im, counter, nb_stages + 1, re_ref, im_ref);
+                    REQUIRE(re_out == re_ref);
+                    REQUIRE(im_out == im_ref);
+                } else if (stages == 1) {
+                    ap_int<Out_W> re_ref, im_ref;
+                    cordic_rom::cordic(re, im, counter, 0, re_ref, im_ref);
+                    REQUIRE(re_out == re_ref);
+                    REQUIRE(im_out == im_ref);
+                    REQUIRE(cordic_rom::scale_cordic(re_out, 1) == cordic_rom::scale_cordic(re_ref, 0));
+                }
+
+                const std::complex<double> expected = std::complex<double>(double(re), double(im)) / double(cordic_rom::in_scale_factor)
+                                                    * std::polar(1., cordic_rom::rotation / double(cordic_rom::q) * double(counter));
+                const std::complex<double> obtained(cordic_rom::scale_cordic(re_out.to_double(), stages) / out_scale,
+                                                    cordic_rom::scale_cordic(im_out.to_double(), stages) / out_scale);
+                max_error = std::max(max_error, std::abs(obtained - expected));
+            }
+        }
+
+        // Each extra stage halves the angular error, up to the rounding of the datapath.
+        REQUIRE(max_error < previous_error * 1.05);
+        previous_error = max_error;
+    }
+}
+
+#if 0
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) straight-line kernels are bit-exact", "[CORDIC]") {
+    constexpr unsigned In_W       = cordic_rom::In_W;
+    constexpr unsigned Out_W      = cordic_rom::Out_W;
+    constexpr uint64_t max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    for (uint64_t counter = 0; counter < max_length; counter++) {
+        for (int64_t re = -in_max - 1; re <= in_max; re += in_max / 7) {
+            const int64_t im = (re * 7 + int64_t(counter) * 131) % in_max;
+
+            ap_int<Out_W> re_out, im_out, re_ref, im_ref;
+            cordic_rom::cordic(re, im, counter, re_ref, im_ref);
+            cordic_rom::cordic_kernel(re, im, counter, re_out, im_out);
+            REQUIRE(re_out == re_ref);
+            REQUIRE(im_out == im_ref);
+        }
+    }
+
+    ap_int<Out_W> re_out, im_out, re_ref, im_ref;
+    cordic_rom::cordic(in_max, -in_max - 1, max_length - 1, re_ref, im_ref);
+    cordic_rom::cordic_kernel<max_length - 1>(in_max, -in_max - 1, re_out, im_out);
+    REQUIRE(re_out == re_ref);
+    REQUIRE(im_out == im_ref);
+
+    // Addresses outside the ROM zero the outputs instead of leaving them unassigned.
+    cordic_roms::ml_16_6_64_2_kernel(in_max, -in_max - 1, max_length, re_out, im_out);
+    REQUIRE(re_out == 0);
+    REQUIRE(im_out == 0);
+}
+#endif
+
+#if defined(SOFTWARE)
+TEST_CASE("ROM-based Cordic (TPL ml, 16, 6, 64, 2) constexpr are evaluated during compilation.", "[CORDIC]") {
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - div:2 - C-Types") {
+
+        constexpr complex<int64_t> value_in = (1U << 12) * 97;
+        constexpr uint8_t          angle    = 169;
+
+        constexpr complex<int64_t> res1 = cordic_rom::cordic(value_in, angle);
+        constexpr complex<int64_t> res2 = cordic_rom::cordic(value_in, angle);
+        static_assert(res1 == res2, "Test");
+        REQUIRE_FALSE(res1 == cordic_rom::cordic(complex<int64_t>(1, 0), angle));
+        REQUIRE(res1 == cordic_rom::cordic(value_in, angle));
+    }
+}
+#endif
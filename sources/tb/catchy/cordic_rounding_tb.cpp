@@ -0,0 +1,114 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRounded/CCordicRotateRounded.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <cmath>
+#include <complex>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+// SNR of the gain-compensated outputs against a double-precision rotation, at every address.
+template <class Cordic>
+double snr_db(size_t samples_per_address) {
+    constexpr int64_t in_max = (int64_t(1) << (Cordic::In_W - 1)) - 1;
+
+    const double in_scale  = double(1ULL << (Cordic::In_W - Cordic::In_I));
+    const double out_scale = double(1ULL << (Cordic::Out_W - Cordic::Out_I));
+    const double kn        = rcr::kn_values[Cordic::nb_stages - 1];
+
+    double   signal = 0., noise = 0.;
+    rcr::lcg rng;
+    for (unsigned n = 0; n < Cordic::max_length; n++) {
+        for (size_t i = 0; i < samples_per_address; i++) {
+            const int64_t re = rng.uniform(-in_max, in_max);
+            const int64_t im = rng.uniform(-in_max, in_max);
+
+            ap_int<Cordic::Out_W> re_out, im_out;
+            Cordic::cordic(re, im, n, re_out, im_out);
+
+            // The reference is the ideal CORDIC, whose angle is the one of its control word.
+            const double          angle = rcr::rom_angle(Cordic::cordic_t::rom_cordic.rom[n], Cordic::nb_stages);
+            const complex<double> expected = complex<double>(re / in_scale, im / in_scale) * polar(1., angle);
+            const complex<double> obtained(re_out.to_double() * kn / out_scale, im_out.to_double() * kn / out_scale);
+
+            signal += norm(expected);
+            noise += norm(obtained - expected);
+        }
+    }
+    return 10. * log10(signal / noise);
+}
+
+} // namespace
+
+TEST_CASE("Stage shifts follow the rounding mode", "[ROUNDING]") {
+    // Ties of 2.5, -2.5, 3.5 and -3.5, then values off the tie.
+    REQUIRE(rcr::round_shift<rounding_mode::truncate>(5, 1) == 2);
+    REQUIRE(rcr::round_shift<rounding_mode::truncate>(-5, 1) == -3);
+    REQUIRE(rcr::round_shift<rounding_mode::half_up>(5, 1) == 3);
+    REQUIRE(rcr::round_shift<rounding_mode::half_up>(-5, 1) == -2);
+    REQUIRE(rcr::round_shift<rounding_mode::convergent>(5, 1) == 2);
+    REQUIRE(rcr::round_shift<rounding_mode::convergent>(-5, 1) == -2);
+    REQUIRE(rcr::round_shift<rounding_mode::convergent>(7, 1) == 4);
+    REQUIRE(rcr::round_shift<rounding_mode::convergent>(-7, 1) == -4);
+
+    REQUIRE(rcr::round_shift<rounding_mode::half_up>(11, 2) == 3);
+    REQUIRE(rcr::round_shift<rounding_mode::convergent>(-11, 2) == -3);
+    REQUIRE(rcr::round_shift<rounding_mode::convergent>(9, 2) == 2);
+    REQUIRE(rcr::round_shift<rounding_mode::half_up>(-9, 0) == -9);
+}
+
+TEST_CASE("Default policies are bit-exact with the AP-Types CORDIC", "[ROUNDING]") {
+    typedef CCordicRotateConstexpr<8, 3, 6, 64, 2> cordic;
+    typedef CCordicRotateRounded<8, 3, 6, 64, 2>   rounded;
+
+    for (unsigned n = 0; n < cordic::max_length; n++) {
+        for (int64_t re = -128; re < 128; re++) {
+            for (int64_t im = -128; im < 128; im += 3) {
+                ap_int<cordic::Out_W> re_ref, im_ref, re_out, im_out;
+                cordic::cordic(re, im, n, re_ref, im_ref);
+                rounded::cordic(re, im, n, re_out, im_out);
+                REQUIRE(re_out == re_ref);
+                REQUIRE(im_out == im_ref);
+            }
+        }
+    }
+}
+
+TEST_CASE("Rounding and guard bits buy SNR back from the datapath width", "[ROUNDING]") {
+    const double truncated = snr_db<CCordicRotateRounded<12, 3, 6, 64, 2>>(64);
+
+    const double half_up    = snr_db<CCordicRotateRounded<12, 3, 6, 64, 2, rounding_mode::half_up>>(64);
+    const double convergent = snr_db<CCordicRotateRounded<12, 3, 6, 64, 2, rounding_mode::convergent>>(64);
+    const double guarded    = snr_db<CCordicRotateRounded<12, 3, 6, 64, 2, rounding_mode::convergent, 3>>(64);
+
+    // One output bit less than the default datapath.
+    const double narrow = snr_db<CCordicRotateRounded<12, 3, 6, 64, 2, rounding_mode::convergent, 2, 13>>(64);
+
+    REQUIRE(half_up > truncated + 2.);
+    REQUIRE(convergent > truncated + 2.);
+    REQUIRE(guarded > convergent + 5.);
+    REQUIRE(narrow > truncated + 2.);
+}
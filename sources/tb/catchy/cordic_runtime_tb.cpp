@@ -0,0 +1,295 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRegistry/CCordicRotateRegistry.hpp"
+#include "CCordicRotateRuntime/CCordicRotateRuntime.hpp"
+#include "RomBundle/RomBundle.hpp"
+#include "RomGeneratorML/RomGeneratorML.hpp"
+#include "RomGeneratorRuntime/RomGeneratorRuntime.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+TEST_CASE("Runtime ROM generator matches the template generators", "[ROM]") {
+    SECTION("cst - W:16 - Stages:6 - q:64 - divider:2") {
+        constexpr CRomGeneratorConst<16, 6, 64, 2> expected {};
+        const CRomGeneratorRuntime                 rom(rcr::generator_type::cst, 16, 6, 64, 2);
+
+        constexpr unsigned max_length  = expected.max_length;
+        constexpr unsigned addr_length = expected.addr_length;
+
+        REQUIRE(rom.max_length == max_length);
+        REQUIRE(rom.addr_length == addr_length);
+        for (unsigned n = 0; n < rom.max_length; n++) {
+            REQUIRE(rom.rom[n] == expected.rom[n]);
+        }
+    }
+
+    SECTION("ml - W:12 - Stages:4 - q:32 - divider:4") {
+        const CRomGeneratorML<12, 4, 32, 4> expected;
+        const CRomGeneratorRuntime          rom(rcr::generator_type::ml, 12, 4, 32, 4);
+
+        constexpr unsigned max_length = expected.max_length;
+
+        REQUIRE(rom.max_length == max_length);
+        for (unsigned n = 0; n < rom.max_length; n++) {
+            REQUIRE(rom.rom[n] == expected.rom[n]);
+        }
+    }
+}
+
+TEST_CASE("Runtime CORDIC is bit-exact with the AP-Types one", "[CORDIC]") {
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - divider:2") {
+        typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic_rom;
+
+        const CRomGeneratorRuntime rom(rcr::generator_type::cst, 16, 6, 64, 2);
+        const CCordicRotateRuntime cordic(16, 4, 6, 64, 2, rom.rom.data());
+
+        constexpr unsigned Out_W            = cordic_rom::Out_W;
+        constexpr unsigned kn_i             = cordic_rom::kn_i;
+        constexpr unsigned out_scale_factor = cordic_rom::out_scale_factor;
+
+        REQUIRE(cordic.Out_W == Out_W);
+        REQUIRE(cordic.kn_i == kn_i);
+        REQUIRE(cordic.out_scale_factor == out_scale_factor);
+
+        for (unsigned n = 0; n < cordic.max_length; n++) {
+            for (int64_t re = -32768; re < 32768; re += 1021) {
+                const int64_t im = (re * 7 + 12345) % 32768;
+
+                ap_int<cordic_rom::Out_W> re_exp, im_exp;
+                cordic_rom::cordic(ap_int<16>(re), ap_int<16>(im), n, re_exp, im_exp);
+
+                int64_t re_out, im_out;
+                cordic.cordic(re, im, n, re_out, im_out);
+
+                REQUIRE(re_out == re_exp.to_int64());
+                REQUIRE(im_out == im_exp.to_int64());
+                REQUIRE(cordic.scale_cordic(re_out) == cordic_rom::scale_cordic(re_exp).to_int64());
+            }
+        }
+    }
+
+    SECTION("W:16 - I:4 - Stages:7 - q:64 - divider:4") {
+        typedef CCordicRotateConstexpr<16, 4, 7, 64, 4> cordic_rom;
+
+        const CRomGeneratorRuntime rom(rcr::generator_type::cst, 16, 7, 64, 4);
+        const CCordicRotateRuntime cordic(16, 4, 7, 64, 4, rom.rom.data());
+
+        for (unsigned n = 0; n < cordic.max_length; n++) {
+            for (int64_t re = -32768; re < 32768; re += 2039) {
+                const int64_t im = -re / 3;
+
+                ap_int<cordic_rom::Out_W> re_exp, im_exp;
+                cordic_rom::cordic(ap_int<16>(re), ap_int<16>(im), n, re_exp, im_exp);
+
+                int64_t re_out, im_out;
+                cordic.cordic(re, im, n, re_out, im_out);
+
+                REQUIRE(re_out == re_exp.to_int64());
+                REQUIRE(im_out == im_exp.to_int64());
+            }
+        }
+    }
+}
+
+TEST_CASE("ROM bundles are written and mapped back without copy", "[ROM]") {
+    const char bundle_fn[] = "cordic_runtime_tb_bundle.bin";
+
+    vector<CRomGeneratorRuntime> roms;
+    roms.emplace_back(rcr::generator_type::cst, 16, 6, 64, 2);
+    roms.emplace_back(rcr::generator_type::ml, 12, 4, 32, 4);
+    roms.emplace_back(rcr::generator_type::cst, 8, 3, 48, 1);
+
+    REQUIRE(write_rom_bundle(bundle_fn, roms));
+
+    {
+        const CRomBundle bundle(bundle_fn);
+        REQUIRE(bundle.is_open());
+        REQUIRE(bundle.size() == roms.size());
+
+        for (const CRomGeneratorRuntime & expected : roms) {
+            const rcr::rom_bundle_entry * entry = bundle.find(expected.type, expected.In_W, expected.nb_stages, expected.q, expected.divider);
+            REQUIRE(entry != nullptr);
+            REQUIRE(entry->length == expected.max_length);
+            REQUIRE(entry->offset % 8 == 0);
+
+            const uint8_t * rom = bundle.rom(*entry);
+            for (unsigned n = 0; n < expected.max_length; n++) {
+                REQUIRE(rom[n] == expected.rom[n]);
+            }
+        }
+
+        REQUIRE(bundle.find(rcr::generator_type::ml, 16, 6, 64, 2) == nullptr);
+
+        typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic_rom;
+
+        const rcr::rom_bundle_entry * entry = bundle.find(rcr::generator_type::cst, 16, 6, 64, 2);
+        const CCordicRotateRuntime    cordic(entry->In_W, 4, entry->nb_stages, entry->q, entry->divider, bundle.rom(*entry));
+
+        for (unsigned n = 0; n < cordic.max_length; n++) {
+            ap_int<cordic_rom::Out_W> re_exp, im_exp;
+            cordic_rom::cordic(ap_int<16>(12345), ap_int<16>(-2345), n, re_exp, im_exp);
+
+            int64_t re_out, im_out;
+            cordic.cordic(12345, -2345, n, re_out, im_out);
+
+            REQUIRE(re_out == re_exp.to_int64());
+            REQUIRE(im_out == im_exp.to_int64());
+        }
+    }
+
+    // Offsets wrapping around, or not aligned as written, are rejected.
+    const long offset_position = long(sizeof(rcr::rom_bundle_header) + offsetof(rcr::rom_bundle_entry, offset));
+    for (const uint64_t offset : {~uint64_t(7U), uint64_t(sizeof(rcr::rom_bundle_header) + 3 * sizeof(rcr::rom_bundle_entry) + 1)}) {
+        FILE * patched = fopen(bundle_fn, "r+b");
+        REQUIRE(patched != nullptr);
+        fseek(patched, offset_position, SEEK_SET);
+        fwrite(&offset, sizeof(offset), 1, patched);
+        fclose(patched);
+
+        CRomBundle bundle;
+        REQUIRE_FALSE(bundle.open(bundle_fn));
+    }
+
+    // A bad magic is rejected on its own, the rest of the bundle being valid again.
+    REQUIRE(write_rom_bundle(bundle_fn, roms));
+    REQUIRE(CRomBundle(bundle_fn).is_open());
+
+    FILE * corrupted = fopen(bundle_fn, "r+b");
+    REQUIRE(corrupted != nullptr);
+    fputc('X', corrupted);
+    fclose(corrupted);
+
+    CRomBundle bundle;
+    REQUIRE_FALSE(bundle.open(bundle_fn));
+    REQUIRE_FALSE(bundle.is_open());
+
+    remove(bundle_fn);
+}
+
+TEST_CASE("Registry hands out rotators matching their template instance", "[CORDIC]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic_16;
+    typedef CCordicRotateConstexpr<12, 4, 4, 64, 4> cordic_12;
+    typedef CCordicRotateRegistry<cordic_16, cordic_12> registry;
+
+    REQUIRE(registry::contains(12, 4, 4, 64, 4));
+    REQUIRE_FALSE(registry::contains(12, 4, 4, 64, 2));
+    REQUIRE(registry::make_rotator(16, 3, 6, 64) == nullptr);
+
+    const unique_ptr<CCordicRotator> rotator = registry::make_rotator(12, 4, 4, 64, 4);
+    REQUIRE(rotator != nullptr);
+    REQUIRE(rotator->max_length == 512);
+
+    constexpr size_t length = 2000;
+
+    vector<int32_t>  re_in(length), im_in(length), re_out(length), im_out(length), re_seq(length), im_seq(length);
+    vector<uint32_t> counters(length);
+    for (size_t i = 0; i < length; i++) {
+        re_in[i]    = int32_t((i * 37) % 4096) - 2048;
+        im_in[i]    = int32_t((i * 91) % 4096) - 2048;
+        counters[i] = uint32_t((i + 100) % rotator->max_length);
+    }
+
+    rotator->cordic(re_in.data(), im_in.data(), counters.data(), re_out.data(), im_out.data(), length);
+    rotator->cordic(re_in.data(), im_in.data(), 100, re_seq.data(), im_seq.data(), length);
+
+    for (size_t i = 0; i < length; i++) {
+        ap_int<cordic_12::Out_W> re_exp, im_exp;
+        cordic_12::cordic(ap_int<12>(re_in[i]), ap_int<12>(im_in[i]), counters[i], re_exp, im_exp);
+
+        REQUIRE(re_out[i] == re_exp.to_int());
+        REQUIRE(im_out[i] == im_exp.to_int());
+        REQUIRE(re_seq[i] == re_out[i]);
+        REQUIRE(im_seq[i] == im_out[i]);
+    }
+
+    rotator->scale_cordic(re_out.data(), length);
+    REQUIRE(re_out[5] == cordic_12::scale_cordic(ap_int<cordic_12::Out_W>(re_seq[5])).to_int());
+}
+
+namespace {
+
+// The ML ROM of the same parameters as cordic_16, behind the static interface of the registered rotators.
+struct cordic_ml_16 : CCordicRotateConstexpr<16, 4, 6, 64, 2> {
+    static constexpr rcr::generator_type rom_type = rcr::generator_type::ml;
+
+    static void cordic(const ap_int<In_W> & re_in, const ap_int<In_W> & im_in, const ap_uint<addr_length> & counter,
+                       ap_int<Out_W> & re_out, ap_int<Out_W> & im_out) {
+        static const CRomGeneratorML<16, 6, 64, 2> rom {};
+        static const CCordicRotateRuntime          rotator(In_W, In_I, nb_stages, q, divider, rom.rom);
+
+        int64_t re, im;
+        rotator.cordic(re_in.to_int64(), im_in.to_int64(), counter.to_uint64(), re, im);
+        re_out = re;
+        im_out = im;
+    }
+};
+
+} // namespace
+
+TEST_CASE("Registry tells cst and ml rotators of the same parameters apart", "[CORDIC]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2>            cordic_cst_16;
+    typedef CCordicRotateRegistry<cordic_cst_16, cordic_ml_16> registry;
+
+    REQUIRE(registry::contains(16, 4, 6, 64, 2));
+    REQUIRE(registry::contains(16, 4, 6, 64, 2, rcr::generator_type::ml));
+    REQUIRE_FALSE(CCordicRotateRegistry<cordic_cst_16>::contains(16, 4, 6, 64, 2, rcr::generator_type::ml));
+
+    const unique_ptr<CCordicRotator> cst = registry::make_rotator(16, 4, 6, 64, 2, rcr::generator_type::cst);
+    const unique_ptr<CCordicRotator> ml  = registry::make_rotator(16, 4, 6, 64, 2, rcr::generator_type::ml);
+    REQUIRE(cst != nullptr);
+    REQUIRE(ml != nullptr);
+    REQUIRE(cst->rom_type == rcr::generator_type::cst);
+    REQUIRE(ml->rom_type == rcr::generator_type::ml);
+
+    constexpr size_t length = 2000;
+
+    vector<int32_t> re_in(length), im_in(length), re_cst(length), im_cst(length), re_ml(length), im_ml(length);
+    for (size_t i = 0; i < length; i++) {
+        re_in[i] = int32_t((i * 37) % 65536) - 32768;
+        im_in[i] = int32_t((i * 91) % 65536) - 32768;
+    }
+
+    cst->cordic(re_in.data(), im_in.data(), 0U, re_cst.data(), im_cst.data(), length);
+    ml->cordic(re_in.data(), im_in.data(), 0U, re_ml.data(), im_ml.data(), length);
+
+    bool differ = false;
+    for (size_t i = 0; i < length; i++) {
+        const uint32_t counter = uint32_t(i % cordic_ml_16::max_length);
+
+        ap_int<cordic_ml_16::Out_W> re_exp, im_exp;
+        cordic_cst_16::cordic(ap_int<16>(re_in[i]), ap_int<16>(im_in[i]), counter, re_exp, im_exp);
+        REQUIRE(re_cst[i] == re_exp.to_int());
+        REQUIRE(im_cst[i] == im_exp.to_int());
+
+        cordic_ml_16::cordic(ap_int<16>(re_in[i]), ap_int<16>(im_in[i]), counter, re_exp, im_exp);
+        REQUIRE(re_ml[i] == re_exp.to_int());
+        REQUIRE(im_ml[i] == im_exp.to_int());
+
+        differ = differ || re_ml[i] != re_cst[i] || im_ml[i] != im_cst[i];
+    }
+    REQUIRE(differ);
+}
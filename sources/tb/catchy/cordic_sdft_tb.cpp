@@ -0,0 +1,102 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicSlidingDFT/CCordicSlidingDFT.hpp"
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+using Catch::Matchers::Floating::WithinAbsMatcher;
+
+TEST_CASE("Sliding DFT accumulators are exact sums of CORDIC rotations", "[SDFT]") {
+    typedef CCordicRotateConstexpr<14, 2, 6, 32, 2> cordic_rom;
+    typedef CCordicSlidingDFT<cordic_rom, 32, 4>    sdft;
+
+    constexpr unsigned N          = sdft::length;
+    constexpr unsigned max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (cordic_rom::In_W - 1)) - 1;
+
+    const unsigned bins[4] = {0, 1, 7, 31};
+    sdft           dft(bins);
+
+    vector<int64_t> re(300), im(300);
+    for (unsigned n = 0; n < re.size(); n++) {
+        re[n] = (int64_t(n) * 7919 + 13) % (2 * in_max + 1) - in_max;
+        im[n] = (int64_t(n) * 104729 + 7) % (2 * in_max + 1) - in_max;
+    }
+
+    for (unsigned n = 0; n < re.size(); n++) {
+        dft.push(re[n], im[n]);
+
+        for (unsigned k = 0; k < 4; k++) {
+            int64_t acc_re = 0, acc_im = 0;
+            for (unsigned m = (n + 1 >= N ? n + 1 - N : 0); m <= n; m++) {
+                const uint64_t counter = (max_length - (uint64_t(bins[k]) * m % N) * (max_length / N)) % max_length;
+
+                ap_int<cordic_rom::Out_W> re_out, im_out;
+                cordic_rom::cordic(re[m], im[m], counter, re_out, im_out);
+                acc_re += re_out.to_int64();
+                acc_im += im_out.to_int64();
+            }
+            REQUIRE(dft.accumulator(k) == complex<int64_t>(acc_re, acc_im));
+        }
+    }
+}
+
+TEST_CASE("Sliding DFT tracks the bins of a double-precision DFT", "[SDFT]") {
+    typedef CCordicRotateConstexpr<16, 4, 7, 64, 2> cordic_rom;
+    typedef CCordicSlidingDFT<cordic_rom, 64, 3>    sdft;
+
+    constexpr unsigned N        = sdft::length;
+    constexpr double   in_scale = double(cordic_rom::in_scale_factor);
+
+    const unsigned bins[3] = {5, 12, 40};
+    sdft           dft(bins);
+
+    vector<complex<double>> x(1000);
+    for (unsigned n = 0; n < x.size(); n++) {
+        x[n] = 3. * polar(1., rcr::two_pi * 5. * n / N) + 0.5 * polar(1., -rcr::two_pi * 24. * n / N + 0.3)
+             + complex<double>(0.2 * sin(0.37 * n), 0.1 * cos(1.3 * n));
+
+        dft.push(int64_t(lround(x[n].real() * in_scale)), int64_t(lround(x[n].imag() * in_scale)));
+
+        if (n + 1 < N) {
+            continue;
+        }
+
+        for (unsigned k = 0; k < 3; k++) {
+            complex<double> expected = 0.;
+            for (unsigned m = n + 1 - N; m <= n; m++) {
+                expected += x[m] * polar(1., -rcr::two_pi * double((bins[k] * m) % N) / N);
+            }
+
+            REQUIRE_THAT(dft.bin(k).real(), WithinAbsMatcher(expected.real(), 8. * N * 2. / 100.));
+            REQUIRE_THAT(dft.bin(k).imag(), WithinAbsMatcher(expected.imag(), 8. * N * 2. / 100.));
+        }
+    }
+
+    REQUIRE(abs(dft.bin(0)) == Approx(3. * N).epsilon(0.02));
+    REQUIRE(abs(dft.bin(1)) < 0.1 * N);
+}
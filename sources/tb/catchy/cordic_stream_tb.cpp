@@ -0,0 +1,147 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicStream/CCordicStream.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+typedef CCordicStreamModel<cordic>              model_t;
+
+vector<stream_input<cordic>> random_inputs(size_t length) {
+    constexpr int64_t in_max = (int64_t(1) << (cordic::In_W - 1)) - 1;
+
+    vector<stream_input<cordic>> inputs(length);
+    rcr::lcg                     rng;
+    for (stream_input<cordic> & x : inputs) {
+        x.re      = rng.uniform(-in_max, in_max);
+        x.im      = rng.uniform(-in_max, in_max);
+        x.counter = uint32_t(rng.next() >> 32) % cordic::max_length;
+    }
+    return inputs;
+}
+
+// Run the model until every sample has been read back; the producer writes when `produce(cycle)`
+// holds and the consumer reads when `consume(cycle)` holds.
+template <class Produce, class Consume>
+stream_report run(const vector<stream_input<cordic>> & inputs, size_t out_depth, Produce produce, Consume consume) {
+    CStream<stream_input<cordic>>  in(4);
+    CStream<stream_output<cordic>> out(out_depth);
+    model_t                        model(in, out);
+
+    size_t written = 0, read = 0;
+    for (uint64_t cycle = 0; read < inputs.size(); cycle++) {
+        if (written < inputs.size() && produce(cycle) && !in.full()) {
+            in.write(inputs[written++]);
+        }
+
+        model.tick();
+
+        stream_output<cordic> y;
+        if (consume(cycle) && out.read_nb(y)) {
+            const stream_input<cordic> & x = inputs[read++];
+
+            ap_int<cordic::Out_W> re_ref, im_ref;
+            cordic::cordic(x.re, x.im, x.counter, re_ref, im_ref);
+            REQUIRE(y.re == re_ref);
+            REQUIRE(y.im == im_ref);
+        }
+        REQUIRE(cycle < 100 * inputs.size());
+    }
+    return model.stats();
+}
+
+} // namespace
+
+TEST_CASE("The streaming top level matches the ap_int datapath", "[STREAM]") {
+    const vector<stream_input<cordic>> inputs = random_inputs(1000);
+
+    CStream<stream_input<cordic>>  in;
+    CStream<stream_output<cordic>> out;
+    for (const stream_input<cordic> & x : inputs) {
+        in << x;
+    }
+
+    cordic_stream_top<cordic>(in, out, unsigned(inputs.size()));
+    REQUIRE(in.empty());
+    REQUIRE(out.size() == inputs.size());
+
+    for (const stream_input<cordic> & x : inputs) {
+        ap_int<cordic::Out_W> re_ref, im_ref;
+        cordic::cordic(x.re, x.im, x.counter, re_ref, im_ref);
+
+        const stream_output<cordic> y = out.read();
+        REQUIRE(y.re == re_ref);
+        REQUIRE(y.im == im_ref);
+    }
+}
+
+TEST_CASE("The pipeline model sustains one sample per cycle when flowing freely", "[STREAM]") {
+    constexpr unsigned latency = model_t::latency;
+
+    const vector<stream_input<cordic>> inputs = random_inputs(2000);
+    const stream_report                r      = run(
+        inputs, 2, [](uint64_t) { return true; }, [](uint64_t) { return true; });
+
+    REQUIRE(r.samples_in == inputs.size());
+    REQUIRE(r.samples_out == inputs.size());
+    REQUIRE(r.stall_cycles == 0);
+    REQUIRE(r.min_latency == latency);
+    REQUIRE(r.max_latency == latency);
+    REQUIRE(r.max_occupancy == latency);
+    REQUIRE(r.throughput > 0.98);
+}
+
+TEST_CASE("A slow consumer back-pressures the pipeline", "[STREAM]") {
+    constexpr unsigned latency = model_t::latency;
+
+    const vector<stream_input<cordic>> inputs = random_inputs(2000);
+    const stream_report                r      = run(
+        inputs, 1, [](uint64_t) { return true; }, [](uint64_t cycle) { return cycle % 2 == 1; });
+
+    REQUIRE(r.samples_out == inputs.size());
+    REQUIRE(r.stall_cycles > 0);
+    REQUIRE(r.min_latency == latency);
+    REQUIRE(r.max_latency > latency);
+    REQUIRE(r.throughput == Approx(0.5).epsilon(0.02));
+}
+
+TEST_CASE("A bursty producer leaves bubbles in the pipeline", "[STREAM]") {
+    constexpr unsigned latency = model_t::latency;
+
+    const vector<stream_input<cordic>> inputs = random_inputs(2000);
+    const stream_report                r      = run(
+        inputs, 2, [](uint64_t cycle) { return cycle % 32 < 8; }, [](uint64_t) { return true; });
+
+    REQUIRE(r.samples_out == inputs.size());
+    REQUIRE(r.stall_cycles == 0);
+    REQUIRE(r.bubble_cycles > 0);
+    REQUIRE(r.min_latency == latency);
+    REQUIRE(r.max_latency == latency);
+    REQUIRE(r.mean_occupancy < 0.5 * latency);
+    REQUIRE(r.throughput == Approx(0.25).epsilon(0.02));
+}
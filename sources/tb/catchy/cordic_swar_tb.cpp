@@ -0,0 +1,120 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateSwar/CCordicRotateSwar.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+// Every address, with the input extremes and pseudo-random samples.
+template <class Cordic, class Swar>
+void check_bit_exact(size_t samples_per_address) {
+    constexpr unsigned max_length = Cordic::max_length;
+    constexpr int64_t  in_min     = -(int64_t(1) << (Cordic::In_W - 1));
+    constexpr int64_t  in_max     = (int64_t(1) << (Cordic::In_W - 1)) - 1;
+
+    const int64_t extremes[] = {in_min, in_min + 1, -1, 0, 1, in_max};
+
+    rcr::lcg rng;
+    for (unsigned n = 0; n < max_length; n++) {
+        vector<int64_t> re_in, im_in;
+        for (int64_t re : extremes) {
+            for (int64_t im : extremes) {
+                re_in.push_back(re);
+                im_in.push_back(im);
+            }
+        }
+        for (size_t i = 0; i < samples_per_address; i++) {
+            re_in.push_back(rng.uniform(in_min, in_max));
+            im_in.push_back(rng.uniform(in_min, in_max));
+        }
+
+        for (size_t i = 0; i < re_in.size(); i++) {
+            ap_int<Cordic::Out_W> re_ref, im_ref, re_swar, im_swar;
+            Cordic::cordic(re_in[i], im_in[i], n, re_ref, im_ref);
+            Swar::cordic(re_in[i], im_in[i], n, re_swar, im_swar);
+            REQUIRE(re_swar == re_ref);
+            REQUIRE(im_swar == im_ref);
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("SWAR engine is bit-exact with the AP-Types CORDIC", "[SWAR]") {
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - divider:2") {
+        check_bit_exact<CCordicRotateConstexpr<16, 4, 6, 64, 2>, CCordicRotateSwar<16, 4, 6, 64, 2>>(200);
+    }
+
+    SECTION("W:16 - I:4 - Stages:7 - q:64 - divider:4") {
+        check_bit_exact<CCordicRotateConstexpr<16, 4, 7, 64, 4>, CCordicRotateSwar<16, 4, 7, 64, 4>>(200);
+    }
+
+    SECTION("W:8 - I:3 - Stages:6 - q:64 - divider:2") {
+        check_bit_exact<CCordicRotateConstexpr<8, 3, 6, 64, 2>, CCordicRotateSwar<8, 3, 6, 64, 2>>(200);
+    }
+
+    SECTION("W:6 - I:2 - Stages:5 - q:16 - divider:2, every input") {
+        typedef CCordicRotateConstexpr<6, 2, 5, 16, 2> cordic;
+        typedef CCordicRotateSwar<6, 2, 5, 16, 2>      swar;
+
+        for (unsigned n = 0; n < cordic::max_length; n++) {
+            for (int64_t re = -32; re < 32; re++) {
+                for (int64_t im = -32; im < 32; im++) {
+                    ap_int<cordic::Out_W> re_ref, im_ref, re_swar, im_swar;
+                    cordic::cordic(re, im, n, re_ref, im_ref);
+                    swar::cordic(re, im, n, re_swar, im_swar);
+                    REQUIRE(re_swar == re_ref);
+                    REQUIRE(im_swar == im_ref);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("SWAR block rotation matches the scalar one", "[SWAR]") {
+    typedef CCordicRotateSwar<14, 2, 6, 32, 2> swar;
+
+    constexpr size_t   length     = 4096;
+    constexpr unsigned max_length = swar::max_length;
+
+    vector<int32_t>  re_in(length), im_in(length), re_out(length), im_out(length);
+    vector<uint32_t> counters(length);
+    for (size_t i = 0; i < length; i++) {
+        re_in[i]    = int32_t((i * 2654435761U) % 16384U) - 8192;
+        im_in[i]    = int32_t((i * 40503U) % 16384U) - 8192;
+        counters[i] = uint32_t(i % max_length);
+    }
+
+    swar::cordic(re_in.data(), im_in.data(), counters.data(), re_out.data(), im_out.data(), length);
+
+    for (size_t i = 0; i < length; i++) {
+        int64_t re, im;
+        swar::rotate(re_in[i], im_in[i], counters[i], re, im);
+        REQUIRE(re_out[i] == re);
+        REQUIRE(im_out[i] == im);
+    }
+}
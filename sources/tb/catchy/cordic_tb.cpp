@@ -19,6 +19,7 @@
 
 #include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
 #include "CCordicRotateSmart/CCordicRotateSmart.hpp"
+#include "RomRotateCommon/lcg.hpp"
 
 #include <fstream>
 #include <iostream>
@@ -94,6 +95,32 @@ TEST_CASE("Adaptive CORDIC work as intended", "[!mayfail][!hide][WIP]") {
     // Return 0 if the test passed
 }
 
+TEST_CASE("Adaptive CORDIC batch API is bit-exact with the scalar one", "[CORDIC]") {
+    constexpr size_t n_values = (1U << 14) + 37; // Every angle, and a partial block
+
+    vector<ap_fixed<14, 4>> angles(n_values);
+    vector<ap_fixed<17, 5>> re_in(n_values), im_in(n_values);
+    vector<ap_fixed<19, 7>> re_out(n_values), im_out(n_values);
+
+    rcr::lcg rng;
+    for (size_t i = 0; i < n_values; i++) {
+        const uint64_t r = rng.next();
+        angles[i].V      = uint64_t(i);
+        re_in[i].V       = r >> 20;
+        im_in[i].V       = r >> 40;
+    }
+
+    cordic_legacy::process(angles.data(), re_in.data(), im_in.data(), re_out.data(), im_out.data(), n_values);
+
+    for (size_t i = 0; i < n_values; i++) {
+        ap_fixed<19, 7> re_ref, im_ref;
+        cordic_legacy::process(angles[i], re_in[i], im_in[i], re_ref, im_ref);
+
+        REQUIRE(re_out[i].bits_to_uint64() == re_ref.bits_to_uint64());
+        REQUIRE(im_out[i].bits_to_uint64() == im_ref.bits_to_uint64());
+    }
+}
+
 #if defined(SOFTWARE)
 TEST_CASE("ROM-based Cordic works with C-Types", "[CORDIC]") {
     SECTION("W:16 - I:4 - Stages:6 - q:64") {
@@ -508,4 +535,124 @@ TEST_CASE("ROM-based Cordic constexpr are evaluated during compilation.", "[CORD
         REQUIRE(res1 == cordic_rom::cordic(value_in, angle));
     }
 }
-#endif
\ No newline at end of file
+#endif
+
+TEST_CASE("ROM-based Cordic dual rotation matches two single rotations", "[CORDIC]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 4> cordic_rom;
+
+    constexpr unsigned In_W       = cordic_rom::In_W;
+    constexpr unsigned Out_W      = cordic_rom::Out_W;
+    constexpr uint64_t max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    for (uint64_t counter = 0; counter < max_length; counter++) {
+        for (int64_t re = -in_max - 1; re <= in_max; re += 4099) {
+            // -2^(In_W - 1) is its own opposite on In_W bits, in both inputs.
+            for (const int64_t im : {(re * 7 + int64_t(counter) * 131) % in_max, -in_max - 1}) {
+                ap_int<Out_W> re_pos, im_pos, re_neg, im_neg;
+                cordic_rom::cordic_dual(re, im, counter, re_pos, im_pos, re_neg, im_neg);
+
+                ap_int<Out_W> re_ref, im_ref;
+                cordic_rom::cordic(re, im, counter, re_ref, im_ref);
+                REQUIRE(re_pos == re_ref);
+                REQUIRE(im_pos == im_ref);
+
+                cordic_rom::cordic(re, -im, counter, re_ref, im_ref);
+                REQUIRE(re_neg == re_ref);
+                REQUIRE(im_neg == ap_int<Out_W>(-im_ref));
+
+#if defined(SOFTWARE)
+                complex<int64_t> x_pos, x_neg;
+                cordic_rom::cordic_dual(complex<int64_t>(re, im), counter, x_pos, x_neg);
+                REQUIRE(x_pos == cordic_rom::cordic(complex<int64_t>(re, im), counter));
+                REQUIRE(x_neg == conj(cordic_rom::cordic(complex<int64_t>(re, -im), counter)));
+#endif
+            }
+        }
+    }
+}
+
+namespace {
+
+// A `stages`-stage rotation through the ROM of the 7-stage rotator, against the dedicated one.
+template <unsigned stages>
+void check_early_termination() {
+    typedef CCordicRotateConstexpr<16, 4, 7, 64, 4>      full_rom;
+    typedef CCordicRotateConstexpr<16, 4, stages, 64, 4> short_rom;
+
+    constexpr unsigned In_W       = full_rom::In_W;
+    constexpr unsigned Out_W      = full_rom::Out_W;
+    constexpr uint64_t max_length = full_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    for (uint64_t counter = 0; counter < max_length; counter++) {
+        for (int64_t re = -in_max; re <= in_max; re += 4099) {
+            const int64_t im = (re * 7 + int64_t(counter) * 131) % in_max;
+
+            ap_int<Out_W> re_out, im_out, re_ref, im_ref;
+            full_rom::cordic(re, im, counter, stages, re_out, im_out);
+            short_rom::cordic(re, im, counter, re_ref, im_ref);
+            REQUIRE(re_out == re_ref);
+            REQUIRE(im_out == im_ref);
+            REQUIRE(full_rom::scale_cordic(re_out, stages) == short_rom::scale_cordic(re_ref));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("ROM-based Cordic early termination matches a shorter rotator", "[CORDIC]") {
+    typedef CCordicRotateConstexpr<16, 4, 7, 64, 4> cordic_rom;
+
+    constexpr unsigned In_W       = cordic_rom::In_W;
+    constexpr unsigned Out_W      = cordic_rom::Out_W;
+    constexpr unsigned nb_stages  = cordic_rom::nb_stages;
+    constexpr uint64_t max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    for (uint64_t counter = 0; counter < max_length; counter++) {
+        ap_int<Out_W> re_out, im_out, re_ref, im_ref;
+        cordic_rom::cordic(in_max, -in_max / 3, counter, nb_stages, re_out, im_out);
+        cordic_rom::cordic(in_max, -in_max / 3, counter, re_ref, im_ref);
+        REQUIRE(re_out == re_ref);
+        REQUIRE(im_out == im_ref);
+    }
+
+    // The constant-rotation ROM is built greedily, so that its words are prefix-consistent.
+    check_early_termination<2>();
+    check_early_termination<3>();
+    check_early_termination<4>();
+    check_early_termination<5>();
+    check_early_termination<6>();
+}
+
+TEST_CASE("ROM-based Cordic early termination clamps the stage count", "[CORDIC]") {
+    typedef CCordicRotateConstexpr<16, 4, 7, 64, 4> cordic_rom;
+
+    constexpr unsigned In_W       = cordic_rom::In_W;
+    constexpr unsigned Out_W      = cordic_rom::Out_W;
+    constexpr unsigned nb_stages  = cordic_rom::nb_stages;
+    constexpr uint64_t max_length = cordic_rom::max_length;
+    constexpr int64_t  in_max     = (int64_t(1) << (In_W - 1)) - 1;
+
+    static_assert(cordic_rom::clamp_stages(0) == 1, "0 stages runs the first one.");
+    static_assert(cordic_rom::clamp_stages(nb_stages + 1) == nb_stages, "Extra stages are ignored.");
+    static_assert(cordic_rom::kn_i_of(0) == cordic_rom::kn_i_of(1), "kn_i_of(0) is kn_i_of(1).");
+    static_assert(cordic_rom::kn_i_of(100) == cordic_rom::kn_i, "kn_i_of(100) is kn_i.");
+
+    for (uint64_t counter = 0; counter < max_length; counter++) {
+        ap_int<Out_W> re_out, im_out, re_ref, im_ref;
+
+        cordic_rom::cordic(in_max, -in_max / 3, counter, 0, re_out, im_out);
+        cordic_rom::cordic(in_max, -in_max / 3, counter, 1, re_ref, im_ref);
+        REQUIRE(re_out == re_ref);
+        REQUIRE(im_out == im_ref);
+        REQUIRE(cordic_rom::scale_cordic(re_out, 0) == cordic_rom::scale_cordic(re_ref, 1));
+
+        cordic_rom::cordic(in_max, -in_max / 3, counter, nb_stages + 1, re_out, im_out);
+        cordic_rom::cordic(in_max, -in_max / 3, counter, re_ref, im_ref);
+        REQUIRE(re_out == re_ref);
+        REQUIRE(im_out == im_ref);
+        REQUIRE(cordic_rom::scale_cordic(re_out, nb_stages + 1) == cordic_rom::scale_cordic(re_ref));
+    }
+}
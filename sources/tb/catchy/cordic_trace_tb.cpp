@@ -0,0 +1,168 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateRounded/CCordicRotateRounded.hpp"
+#include "CCordicRotateSwar/CCordicRotateSwar.hpp"
+#include "CCordicTrace/CCordicTrace.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <cstddef>
+#include <cstdio>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+namespace {
+
+typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+
+// A field-like workload: a slowly drifting carrier over a narrow amplitude range.
+void run_workload(CCordicCapture<cordic> & capture, size_t length) {
+    constexpr unsigned max_length = cordic::max_length;
+
+    rcr::lcg rng;
+    for (size_t i = 0; i < length; i++) {
+        const uint64_t r = rng.next();
+
+        ap_int<cordic::Out_W> re_out, im_out;
+        capture.cordic(ap_int<cordic::In_W>(int64_t((r >> 40) % 2048) - 1024),
+                       ap_int<cordic::In_W>(int64_t((r >> 20) % 2048) - 1024),
+                       (i * 3 + i / 100) % max_length, re_out, im_out);
+    }
+}
+
+} // namespace
+
+TEST_CASE("Captures record every, one in N or the last N samples", "[TRACE]") {
+    CCordicCapture<cordic> full;
+    CCordicCapture<cordic> sampled(capture_mode::sampled, 10);
+    CCordicCapture<cordic> ring(capture_mode::ring, 256);
+    CCordicCapture<cordic> short_ring(capture_mode::ring, 4096);
+
+    run_workload(full, 1000);
+    run_workload(sampled, 1000);
+    run_workload(ring, 1000);
+    run_workload(short_ring, 1000);
+
+    const CCordicTrace all = full.trace();
+    REQUIRE(all.size() == 1000);
+    REQUIRE(all.seen == 1000);
+    REQUIRE(all.has_outputs());
+
+    for (size_t i = 0; i < all.size(); i++) {
+        ap_int<cordic::Out_W> re_out, im_out;
+        cordic::cordic(all.re_in[i], all.im_in[i], all.counters[i], re_out, im_out);
+        REQUIRE(all.re_out[i] == re_out.to_int64());
+        REQUIRE(all.im_out[i] == im_out.to_int64());
+    }
+
+    const CCordicTrace one_in_ten = sampled.trace();
+    REQUIRE(one_in_ten.size() == 100);
+    REQUIRE(one_in_ten.seen == 1000);
+    for (size_t i = 0; i < one_in_ten.size(); i++) {
+        REQUIRE(one_in_ten.counters[i] == all.counters[10 * i + 9]);
+        REQUIRE(one_in_ten.re_out[i] == all.re_out[10 * i + 9]);
+    }
+
+    const CCordicTrace last = ring.trace();
+    REQUIRE(last.size() == 256);
+    for (size_t i = 0; i < last.size(); i++) {
+        REQUIRE(last.re_in[i] == all.re_in[1000 - 256 + i]);
+        REQUIRE(last.counters[i] == all.counters[1000 - 256 + i]);
+        REQUIRE(last.im_out[i] == all.im_out[1000 - 256 + i]);
+    }
+
+    const CCordicTrace not_full = short_ring.trace();
+    REQUIRE(not_full.size() == 1000);
+    REQUIRE(not_full.im_in == all.im_in);
+    REQUIRE(not_full.re_out == all.re_out);
+}
+
+TEST_CASE("Traces are replayed through any engine of their configuration", "[TRACE]") {
+    constexpr unsigned In_W       = cordic::In_W;
+    const char         trace_fn[] = "cordic_trace_tb.trace";
+
+    CCordicCapture<cordic> capture;
+    run_workload(capture, 5000);
+    REQUIRE(capture.trace().save(trace_fn));
+
+    CCordicTrace trace;
+    REQUIRE(trace.load(trace_fn));
+    REQUIRE(trace.size() == 5000);
+    REQUIRE(trace.seen == 5000);
+    REQUIRE(trace.In_W == In_W);
+    REQUIRE(trace.re_in == capture.trace().re_in);
+    REQUIRE(trace.counters == capture.trace().counters);
+    REQUIRE(trace.im_out == capture.trace().im_out);
+
+    const replay_report same = replay_trace(CCordicRotatorInstance<cordic>(), trace, 2);
+    REQUIRE(same.compatible);
+    REQUIRE(same.samples == 5000);
+    REQUIRE(same.mismatches == 0);
+    REQUIRE(same.first_mismatch == 5000);
+    REQUIRE(same.ns_per_sample > 0.);
+
+    const replay_report swar = replay_trace(CCordicRotatorInstance<CCordicRotateSwar<16, 4, 6, 64, 2>>(), trace, 2);
+    REQUIRE(swar.compatible);
+    REQUIRE(swar.mismatches == 0);
+
+    // Not bit-exact: the replay points at the first differing sample.
+    const replay_report rounded = replay_trace(CCordicRotatorInstance<CCordicRotateRounded<16, 4, 6, 64, 2, rounding_mode::convergent>>(), trace, 1);
+    REQUIRE(rounded.compatible);
+    REQUIRE(rounded.mismatches > 0);
+    REQUIRE(rounded.first_mismatch < 5000);
+
+    const replay_report other = replay_trace(CCordicRotatorInstance<CCordicRotateConstexpr<16, 4, 7, 64, 2>>(), trace, 1);
+    REQUIRE_FALSE(other.compatible);
+
+    // Same parameters, but captured from an ML ROM: the cst engines can't reproduce it.
+    REQUIRE(trace.rom_type == rcr::generator_type::cst);
+    CCordicTrace ml_trace = trace;
+    ml_trace.rom_type     = rcr::generator_type::ml;
+    REQUIRE_FALSE(replay_trace(CCordicRotatorInstance<cordic>(), ml_trace, 1).compatible);
+
+    REQUIRE(ml_trace.save(trace_fn));
+    REQUIRE(trace.load(trace_fn));
+    REQUIRE(trace.rom_type == rcr::generator_type::ml);
+
+    // Sample counts disagreeing with the file size are rejected before any allocation.
+    for (const uint64_t count : {~uint64_t(0), uint64_t(5001)}) {
+        FILE * patched = fopen(trace_fn, "r+b");
+        REQUIRE(patched != nullptr);
+        fseek(patched, long(offsetof(rcr::trace_header, count)), SEEK_SET);
+        fwrite(&count, sizeof(count), 1, patched);
+        fclose(patched);
+
+        REQUIRE_FALSE(trace.load(trace_fn));
+        REQUIRE(trace.size() == 0);
+    }
+
+    FILE * corrupted = fopen(trace_fn, "r+b");
+    REQUIRE(corrupted != nullptr);
+    fputc('X', corrupted);
+    fclose(corrupted);
+
+    REQUIRE_FALSE(trace.load(trace_fn));
+    REQUIRE(trace.size() == 0);
+
+    remove(trace_fn);
+}
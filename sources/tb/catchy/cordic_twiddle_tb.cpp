@@ -0,0 +1,82 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "CCordicEngineSelector/CCordicEngineSelector.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "CCordicRotateTwiddle/CCordicRotateTwiddle.hpp"
+
+#include <fstream>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+using namespace std;
+
+using Catch::Matchers::Floating::WithinAbsMatcher;
+
+TEST_CASE("Twiddle engine works with AP-Types", "[TWIDDLE]") {
+    constexpr unsigned n_lines = 100000;
+
+    SECTION("W:16 - I:4 - Stages:6 - q:64 - divider:4") {
+        typedef CCordicRotateTwiddle<16, 4, 6, 64, 4> twiddle;
+
+        constexpr double   rotation = twiddle::rotation;
+        constexpr double   q        = twiddle::q;
+        constexpr uint64_t cnt_mask = 0xFF;
+
+        ifstream INPUT("../data/input.dat");
+
+        constexpr double abs_margin = double(1 << (twiddle::Out_I - 1)) * 2. / 100.;
+
+        for (unsigned iter = 0; iter < n_lines; iter++) {
+            char   sep;
+            double a, b, r;
+            INPUT >> a >> sep >> b >> sep >> r;
+
+            const complex<double> e = complex<double>(a, b) * exp(complex<double>(0., rotation / q * double(iter & cnt_mask)));
+
+            ap_int<twiddle::Out_W> re_out, im_out;
+            twiddle::cordic(ap_int<16>(int64_t(a * double(twiddle::in_scale_factor))),
+                            ap_int<16>(int64_t(b * double(twiddle::in_scale_factor))),
+                            iter & cnt_mask,
+                            re_out, im_out);
+
+            REQUIRE_THAT(twiddle::scale_cordic(re_out.to_double()) / twiddle::out_scale_factor, WithinAbsMatcher(e.real(), abs_margin));
+            REQUIRE_THAT(twiddle::scale_cordic(im_out.to_double()) / twiddle::out_scale_factor, WithinAbsMatcher(e.imag(), abs_margin));
+        }
+    }
+}
+
+TEST_CASE("Engine selector reports every engine side by side", "[TWIDDLE]") {
+    typedef CCordicRotateConstexpr<16, 4, 6, 64, 2> cordic;
+    typedef CCordicRotateTwiddle<16, 4, 6, 64, 2>   twiddle;
+
+    auto selection = CCordicEngineSelector<cordic, twiddle>::select(4096, 2);
+
+    REQUIRE(selection.reports.size() == 2);
+    REQUIRE(selection.rotator != nullptr);
+    REQUIRE(selection.rotator->max_length == 256);
+
+    REQUIRE(string(selection.reports[0].name) == "cordic");
+    REQUIRE(string(selection.reports[1].name) == "twiddle");
+
+    // Same output format: the twiddle table is at least as accurate as a 6-stage CORDIC.
+    REQUIRE(selection.reports[1].snr_db > selection.reports[0].snr_db);
+    REQUIRE(selection.reports[1].max_error < 1e-3);
+}
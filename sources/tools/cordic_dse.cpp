@@ -0,0 +1,281 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_dse.cpp
+ * Design-space exploration of the ROM-based CORDIC rotators.
+ *
+ * Every (type, W, stages, q, divider) combination of the requested ranges is generated and
+ * evaluated at runtime, in parallel, against a double-precision reference. The Pareto front
+ * of (adders, ROM size, SNR) is printed, then the cheapest point meeting the precision target.
+ */
+
+#include "CCordicRotateRuntime/CCordicRotateRuntime.hpp"
+#include "RomGeneratorRuntime/RomGeneratorRuntime.hpp"
+#include "RomRotateCommon/lcg.hpp"
+#include "RomRotateCommon/ranges.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct dse_point {
+    rcr::generator_type type;
+    unsigned            W;
+    unsigned            stages;
+    unsigned            q;
+    unsigned            divider;
+
+    double max_error;
+    double snr_db;
+
+    uint64_t rom_bits;
+    unsigned adders;
+    unsigned adder_bits;
+    unsigned latency;
+
+    bool pareto;
+};
+
+static void evaluate(dse_point & point, unsigned vectors_per_address) {
+    const CRomGeneratorRuntime rom(point.type, point.W, point.stages, point.q, point.divider);
+    // Inputs in [-1; 1[, the two growth bits of the output absorb the CORDIC gain.
+    const CCordicRotateRuntime cordic(point.W, 1, point.stages, point.q, point.divider, rom.rom.data());
+
+    const double in_scale  = double(cordic.in_scale_factor);
+    const double out_scale = double(cordic.out_scale_factor);
+
+    double   signal_power = 0.;
+    double   noise_power  = 0.;
+    double   max_error    = 0.;
+    rcr::lcg rng;
+
+    for (unsigned n = 0; n < cordic.max_length; n++) {
+        const complex<double> phasor = polar(1., cordic.rotation / double(cordic.q) * double(n));
+
+        for (unsigned k = 0; k < vectors_per_address; k++) {
+            const double radius = rng.unit();
+            const double theta  = rng.unit() * rcr::two_pi;
+
+            const int64_t re_in = int64_t(radius * cos(theta) * (in_scale - 1.));
+            const int64_t im_in = int64_t(radius * sin(theta) * (in_scale - 1.));
+
+            int64_t re_out, im_out;
+            cordic.cordic(re_in, im_in, n, re_out, im_out);
+
+            const complex<double> expected = complex<double>(double(re_in) / in_scale, double(im_in) / in_scale) * phasor;
+            const complex<double> obtained(cordic.scale_cordic(double(re_out)) / out_scale,
+                                           cordic.scale_cordic(double(im_out)) / out_scale);
+
+            const double error = abs(obtained - expected);
+
+            signal_power += norm(expected);
+            noise_power += error * error;
+            max_error = max(max_error, error);
+        }
+    }
+
+    point.max_error = max_error;
+    point.snr_db    = noise_power > 0. ? 10. * log10(signal_power / noise_power) : INFINITY;
+
+    // One register per CORDIC stage plus the ROM read and the conditional pi rotation.
+    point.rom_bits   = uint64_t(cordic.max_length) * (point.stages + 1);
+    point.adders     = 2 * (point.stages + 1);
+    point.adder_bits = point.adders * cordic.Out_W;
+    point.latency    = point.stages + 2;
+}
+
+static bool dominates(const dse_point & a, const dse_point & b) {
+    const bool not_worse = a.adder_bits <= b.adder_bits && a.rom_bits <= b.rom_bits && a.snr_db >= b.snr_db;
+    const bool better    = a.adder_bits < b.adder_bits || a.rom_bits < b.rom_bits || a.snr_db > b.snr_db;
+    return not_worse && better;
+}
+
+static void print_header() {
+    printf("%-4s %3s %6s %5s %7s | %10s %8s | %9s %6s %10s %7s\n",
+           "type", "W", "stages", "q", "divider", "max_error", "SNR(dB)", "ROM(bits)", "adders", "adder_bits", "latency");
+}
+
+static void print_point(const dse_point & p) {
+    printf("%-4s %3u %6u %5u %7u | %10.3e %8.2f | %9llu %6u %10u %7u\n",
+           rcr::type_name(p.type), p.W, p.stages, p.q, p.divider, p.max_error, p.snr_db,
+           (unsigned long long) p.rom_bits, p.adders, p.adder_bits, p.latency);
+}
+
+static void usage(const char * name) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --type    LIST   ROM generators among 'cst' and 'ml'        (default: cst)\n"
+            "  --w       RANGE  input bit widths                           (default: 8:16)\n"
+            "  --stages  RANGE  CORDIC stages, within [2; 7]               (default: 2:7)\n"
+            "  --q       RANGE  rotation divisions, a:b doubles            (default: 16:256)\n"
+            "  --divider RANGE  rotation denominators, a:b doubles         (default: 1:4)\n"
+            "  --target-snr dB  minimal SNR of the selected configuration  (default: 60)\n"
+            "  --target-err E   maximal absolute error of the selection    (default: none)\n"
+            "  --vectors N      random inputs evaluated per ROM address    (default: 64)\n"
+            "  --threads N      worker threads                             (default: all cores)\n"
+            "  --all            print every evaluated point\n"
+            "RANGE is either 'a:b' or a comma separated list 'a,b,c'.\n",
+            name);
+}
+
+int main(int argc, char * argv[]) {
+    vector<rcr::generator_type> types    = {rcr::generator_type::cst};
+    vector<unsigned>            widths   = rcr::parse_range("8:16", false);
+    vector<unsigned>            stages   = rcr::parse_range("2:7", false);
+    vector<unsigned>            qs       = rcr::parse_range("16:256", true);
+    vector<unsigned>            dividers = rcr::parse_range("1:4", true);
+
+    double   target_snr = 60.;
+    double   target_err = INFINITY;
+    unsigned vectors    = 64;
+    unsigned threads    = max(1U, thread::hardware_concurrency());
+    bool     print_all  = false;
+
+    for (int i = 1; i < argc; i++) {
+        const string opt(argv[i]);
+        if (opt == "--all") {
+            print_all = true;
+            continue;
+        }
+        if (opt == "--help" || i + 1 >= argc) {
+            usage(argv[0]);
+            return opt == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        const char * value = argv[++i];
+        if (opt == "--type") {
+            types = rcr::parse_types(value);
+        } else if (opt == "--w") {
+            widths = rcr::parse_range(value, false);
+        } else if (opt == "--stages") {
+            stages = rcr::parse_range(value, false);
+        } else if (opt == "--q") {
+            qs = rcr::parse_range(value, true);
+        } else if (opt == "--divider") {
+            dividers = rcr::parse_range(value, true);
+        } else if (opt == "--target-snr") {
+            target_snr = stod(value);
+        } else if (opt == "--target-err") {
+            target_err = stod(value);
+        } else if (opt == "--vectors") {
+            vectors = unsigned(stoul(value));
+        } else if (opt == "--threads") {
+            threads = max(1U, unsigned(stoul(value)));
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    vector<dse_point> points;
+    for (rcr::generator_type t : types) {
+        for (unsigned w : widths) {
+            for (unsigned s : stages) {
+                for (unsigned q : qs) {
+                    for (unsigned d : dividers) {
+                        if (!CRomGeneratorRuntime::valid_parameters(w, s, q, d)) {
+                            fprintf(stderr, "Skipping invalid configuration %s W=%u stages=%u q=%u divider=%u\n",
+                                    rcr::type_name(t), w, s, q, d);
+                            continue;
+                        }
+                        dse_point p {};
+                        p.type    = t;
+                        p.W       = w;
+                        p.stages  = s;
+                        p.q       = q;
+                        p.divider = d;
+                        points.push_back(p);
+                    }
+                }
+            }
+        }
+    }
+
+    fprintf(stderr, "Evaluating %zu configurations on %u threads...\n", points.size(), threads);
+
+    atomic<size_t> next {0};
+    vector<thread> workers;
+    for (unsigned t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < points.size(); i = next++) {
+                evaluate(points[i], vectors);
+            }
+        });
+    }
+    for (thread & worker : workers) {
+        worker.join();
+    }
+
+    for (dse_point & p : points) {
+        p.pareto = none_of(points.begin(), points.end(), [&p](const dse_point & o) { return dominates(o, p); });
+    }
+
+    sort(points.begin(), points.end(), [](const dse_point & a, const dse_point & b) {
+        return a.snr_db != b.snr_db ? a.snr_db < b.snr_db : a.adder_bits < b.adder_bits;
+    });
+
+    if (print_all) {
+        printf("All evaluated configurations:\n");
+        print_header();
+        for (const dse_point & p : points) {
+            print_point(p);
+        }
+        printf("\n");
+    }
+
+    printf("Pareto front (adder bits, ROM bits, SNR):\n");
+    print_header();
+    for (const dse_point & p : points) {
+        if (p.pareto) {
+            print_point(p);
+        }
+    }
+
+    // Cheapest datapath first, then smallest ROM.
+    const dse_point * best = nullptr;
+    for (const dse_point & p : points) {
+        if (p.snr_db < target_snr || p.max_error > target_err) {
+            continue;
+        }
+        if (best == nullptr
+            || p.adder_bits < best->adder_bits
+            || (p.adder_bits == best->adder_bits && p.rom_bits < best->rom_bits)) {
+            best = &p;
+        }
+    }
+
+    printf("\nCheapest configuration with SNR >= %.2f dB and max error <= %g:\n", target_snr, target_err);
+    if (best == nullptr) {
+        printf("none, widen the explored ranges.\n");
+        return EXIT_FAILURE;
+    }
+    print_header();
+    print_point(*best);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_dual_bench.cpp
+ * Throughput of `cordic_dual()` against the two `cordic()` calls it replaces.
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+template <class Cordic>
+void bench() {
+    constexpr unsigned In_W   = Cordic::In_W;
+    constexpr unsigned Out_W  = Cordic::Out_W;
+    constexpr int64_t  in_max = (int64_t(1) << (In_W - 1)) - 1;
+    constexpr size_t   length = 1U << 16;
+    constexpr unsigned runs   = 5;
+
+    vector<ap_int<In_W>>  re_in(length), im_in(length);
+    vector<ap_int<Out_W>> re_pos(length), im_pos(length), re_neg(length), im_neg(length);
+    vector<uint32_t>      counters(length);
+
+    rcr::lcg rng;
+    for (size_t i = 0; i < length; i++) {
+        re_in[i]    = rng.uniform(-in_max, in_max);
+        im_in[i]    = rng.uniform(-in_max, in_max);
+        counters[i] = uint32_t(i % Cordic::max_length);
+    }
+
+    double dual_ns = numeric_limits<double>::infinity();
+    double pair_ns = numeric_limits<double>::infinity();
+    for (unsigned r = 0; r < runs; r++) {
+        auto start = chrono::steady_clock::now();
+        for (size_t i = 0; i < length; i++) {
+            Cordic::cordic_dual(re_in[i], im_in[i], counters[i], re_pos[i], im_pos[i], re_neg[i], im_neg[i]);
+        }
+        auto stop = chrono::steady_clock::now();
+        dual_ns   = min(dual_ns, chrono::duration<double, nano>(stop - start).count() / double(length));
+
+        start = chrono::steady_clock::now();
+        for (size_t i = 0; i < length; i++) {
+            Cordic::cordic(re_in[i], im_in[i], counters[i], re_pos[i], im_pos[i]);
+            Cordic::cordic(re_in[i], ap_int<In_W>(-im_in[i]), counters[i], re_neg[i], im_neg[i]);
+            im_neg[i] = -im_neg[i];
+        }
+        stop    = chrono::steady_clock::now();
+        pair_ns = min(pair_ns, chrono::duration<double, nano>(stop - start).count() / double(length));
+    }
+
+    printf("%3u %6u %5u %7u | %10.2f %10.2f %6.2f\n",
+           In_W, Cordic::nb_stages, Cordic::q, Cordic::divider, dual_ns, pair_ns, dual_ns / pair_ns);
+}
+
+int main(int, char **) {
+    printf("%3s %6s %5s %7s | %10s %10s %6s\n", "W", "stages", "q", "divider", "dual(ns)", "2 x cordic", "ratio");
+
+    bench<CCordicRotateConstexpr<12, 3, 5, 32, 2>>();
+    bench<CCordicRotateConstexpr<16, 4, 6, 64, 2>>();
+    bench<CCordicRotateConstexpr<16, 4, 7, 64, 4>>();
+
+    return EXIT_SUCCESS;
+}
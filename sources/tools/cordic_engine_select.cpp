@@ -0,0 +1,66 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_engine_select.cpp
+ * Side-by-side comparison of the CORDIC, twiddle-table and SWAR engines on a few configurations,
+ * with the engine the selector would pick on this machine.
+ */
+
+#include "CCordicEngineSelector/CCordicEngineSelector.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <tuple>
+
+using namespace std;
+
+template <class... Engines>
+void compare() {
+    typedef typename std::tuple_element<0, std::tuple<Engines...>>::type first_t;
+
+    auto selection = CCordicEngineSelector<Engines...>::select(1U << 16);
+
+    for (size_t e = 0; e < selection.reports.size(); e++) {
+        const engine_report & r = selection.reports[e];
+        printf("%3u %6u %5u %7u | %-8s %10.2f %10.3e %8.2f %s\n",
+               first_t::In_W, first_t::nb_stages, first_t::q, first_t::divider, r.name, r.ns_per_sample, r.max_error, r.snr_db,
+               e == selection.selected ? "<- selected" : "");
+    }
+}
+
+// The SWAR engine is only available up to 16-bit inputs.
+template <unsigned W, unsigned I, unsigned stages, unsigned q, unsigned divider>
+void compare_all() {
+    compare<CCordicRotateConstexpr<W, I, stages, q, divider>,
+            CCordicRotateTwiddle<W, I, stages, q, divider>,
+            CCordicRotateSwar<W, I, stages, q, divider>>();
+}
+
+int main(int, char **) {
+    printf("%3s %6s %5s %7s | %-8s %10s %10s %8s\n", "W", "stages", "q", "divider", "engine", "ns/sample", "max_error", "SNR(dB)");
+
+    compare_all<8, 2, 4, 16, 2>();
+    compare_all<12, 3, 5, 32, 2>();
+    compare_all<16, 4, 6, 64, 2>();
+    compare_all<16, 4, 7, 64, 4>();
+    compare<CCordicRotateConstexpr<24, 4, 7, 256, 2>, CCordicRotateTwiddle<24, 4, 7, 256, 2>>();
+
+    return EXIT_SUCCESS;
+}
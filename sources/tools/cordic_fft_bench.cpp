@@ -0,0 +1,113 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_fft_bench.cpp
+ * Accuracy and throughput of CCordicFFT against a double-precision DFT.
+ */
+
+#include "CCordicFFT/CCordicFFT.hpp"
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+static vector<complex<double>> dft(const vector<complex<double>> & x) {
+    const size_t            N = x.size();
+    vector<complex<double>> X(N);
+    for (size_t k = 0; k < N; k++) {
+        complex<double> acc = 0.;
+        for (size_t n = 0; n < N; n++) {
+            acc += x[n] * polar(1., -rcr::two_pi * double((k * n) % N) / double(N));
+        }
+        X[k] = acc;
+    }
+    return X;
+}
+
+template <class FFT>
+void bench(const char * name) {
+    constexpr unsigned N      = FFT::length;
+    constexpr int64_t  in_max = FFT::in_max;
+    constexpr unsigned runs   = 200;
+
+    vector<int32_t>         re(N), im(N), re_in(N), im_in(N);
+    vector<complex<double>> x(N);
+
+    rcr::lcg rng;
+    for (unsigned n = 0; n < N; n++) {
+        re_in[n] = int32_t(rng.uniform(-in_max / 2, in_max - in_max / 2));
+        im_in[n] = int32_t(rng.uniform(-in_max / 2, in_max - in_max / 2));
+        x[n]     = complex<double>(re_in[n], im_in[n]);
+    }
+
+    const auto dft_start = chrono::steady_clock::now();
+    const auto X         = dft(x);
+    const auto dft_stop  = chrono::steady_clock::now();
+
+    int        exponent  = 0;
+    const auto fft_start = chrono::steady_clock::now();
+    for (unsigned r = 0; r < runs; r++) {
+        re       = re_in;
+        im       = im_in;
+        exponent = FFT::forward(re.data(), im.data());
+    }
+    const auto fft_stop = chrono::steady_clock::now();
+
+    double signal = 0., noise = 0., max_error = 0., peak = 0.;
+    for (unsigned k = 0; k < N; k++) {
+        const complex<double> obtained = complex<double>(re[k], im[k]) * ldexp(1., exponent);
+        const double          error    = abs(obtained - X[k]);
+        signal += norm(X[k]);
+        noise += error * error;
+        max_error = max(max_error, error);
+        peak      = max(peak, abs(X[k]));
+    }
+
+    const double dft_us = chrono::duration<double, micro>(dft_stop - dft_start).count();
+    const double fft_us = chrono::duration<double, micro>(fft_stop - fft_start).count() / runs;
+
+    printf("%-28s %5u %4d | %8.2f %10.3e | %10.2f %10.2f %8.1f\n",
+           name, N, exponent, 10. * log10(signal / noise), max_error / peak, fft_us, dft_us, dft_us / fft_us);
+}
+
+int main(int, char **) {
+    typedef CCordicRotateConstexpr<16, 1, 7, 256, 2> cordic_16_7;
+    typedef CCordicRotateConstexpr<16, 1, 5, 256, 2> cordic_16_5;
+
+    printf("%-28s %5s %4s | %8s %10s | %10s %10s %8s\n",
+           "FFT", "N", "exp", "SNR(dB)", "max_rel_err", "fft(us)", "dft(us)", "speedup");
+
+    bench<CCordicFFT<cordic_16_7, 64, fft_scaling::block_floating_point, 2>>("W16 S7 BFP radix-2");
+    bench<CCordicFFT<cordic_16_7, 64, fft_scaling::block_floating_point, 4>>("W16 S7 BFP radix-4");
+    bench<CCordicFFT<cordic_16_7, 256, fft_scaling::block_floating_point, 2>>("W16 S7 BFP radix-2");
+    bench<CCordicFFT<cordic_16_7, 256, fft_scaling::block_floating_point, 4>>("W16 S7 BFP radix-4");
+    bench<CCordicFFT<cordic_16_7, 256, fft_scaling::per_stage, 4>>("W16 S7 per-stage radix-4");
+    bench<CCordicFFT<cordic_16_5, 256, fft_scaling::block_floating_point, 4>>("W16 S5 BFP radix-4");
+    bench<CCordicFFT<cordic_16_7, 1024, fft_scaling::block_floating_point, 4>>("W16 S7 BFP radix-4");
+
+    return EXIT_SUCCESS;
+}
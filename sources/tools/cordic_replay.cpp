@@ -0,0 +1,91 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_replay.cpp
+ * Replay of a captured trace through every precompiled engine of its configuration,
+ * reporting their throughput and whether they reproduce the recorded outputs.
+ */
+
+#include "CCordicEngineSelector/CCordicEngineSelector.hpp"
+#include "CCordicTrace/CCordicTrace.hpp"
+#include "RomRotateCommon/ranges.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+
+using namespace std;
+
+template <class... Engines>
+unsigned replay(const CCordicTrace & trace, unsigned repetitions) {
+    unique_ptr<CCordicRotator> rotators[] = {unique_ptr<CCordicRotator>(new CCordicRotatorInstance<Engines>())...};
+    const char *               names[]    = {engine_name<Engines>::get()...};
+
+    unsigned replayed = 0;
+    for (size_t e = 0; e < sizeof...(Engines); e++) {
+        const replay_report r = replay_trace(*rotators[e], trace, repetitions);
+        if (!r.compatible) {
+            continue;
+        }
+        replayed++;
+
+        if (trace.has_outputs()) {
+            printf("%-8s %10.2f %10.2f %10zu %s\n", names[e], r.ns_per_sample, r.msamples_per_s, r.mismatches,
+                   r.mismatches == 0 ? "bit-exact" : "differs");
+        } else {
+            printf("%-8s %10.2f %10.2f %10s\n", names[e], r.ns_per_sample, r.msamples_per_s, "-");
+        }
+    }
+    return replayed;
+}
+
+int main(int argc, char ** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s trace [repetitions]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    const unsigned repetitions = argc > 2 ? unsigned(atoi(argv[2])) : 5U;
+
+    CCordicTrace trace;
+    if (!trace.load(argv[1])) {
+        return EXIT_FAILURE;
+    }
+
+    printf("%s: %s ROM, W %u, I %u, stages %u, q %u, divider %u, %zu samples recorded out of %llu\n",
+           argv[1], rcr::type_name(trace.rom_type), trace.In_W, trace.In_I, trace.nb_stages, trace.q, trace.divider,
+           trace.size(), (unsigned long long) trace.seen);
+    printf("%-8s %10s %10s %10s\n", "engine", "ns/sample", "MS/s", "mismatches");
+
+    unsigned replayed = 0;
+    replayed += replay<CCordicRotateConstexpr<8, 3, 6, 64, 2>, CCordicRotateSwar<8, 3, 6, 64, 2>,
+                       CCordicRotateLut<8, 3, 6, 64, 2>, CCordicRotateTwiddle<8, 3, 6, 64, 2>>(trace, repetitions);
+    replayed += replay<CCordicRotateConstexpr<12, 4, 4, 64, 4>, CCordicRotateSwar<12, 4, 4, 64, 4>,
+                       CCordicRotateTwiddle<12, 4, 4, 64, 4>>(trace, repetitions);
+    replayed += replay<CCordicRotateConstexpr<16, 4, 6, 64, 2>, CCordicRotateSwar<16, 4, 6, 64, 2>,
+                       CCordicRotateTwiddle<16, 4, 6, 64, 2>>(trace, repetitions);
+    replayed += replay<CCordicRotateConstexpr<16, 4, 7, 64, 4>, CCordicRotateSwar<16, 4, 7, 64, 4>,
+                       CCordicRotateTwiddle<16, 4, 7, 64, 4>>(trace, repetitions);
+
+    if (replayed == 0) {
+        fprintf(stderr, "No precompiled engine has the configuration of the trace.\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
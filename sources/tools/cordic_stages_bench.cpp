@@ -0,0 +1,105 @@
+/*
+ *
+ * Copyright 2022 Camille "DrasLorus" Monière.
+ *
+ * This file is part of CORDIC_Rotate_APFX.
+ *
+ * This program is free software: you can redistribute it and/or modify it under the terms of the GNU
+ * Lesser General Public License as published by the Free Software Foundation, either version 3 of
+ * the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without
+ * even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License along with this program.
+ * If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * @file cordic_stages_bench.cpp
+ * Accuracy and throughput of the early-terminated rotation, for every stage count of a single ROM.
+ */
+
+#include "CCordicRotateConstexpr/CCordicRotateConstexpr.hpp"
+#include "RomRotateCommon/lcg.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+template <class Cordic>
+void bench() {
+    constexpr unsigned In_W   = Cordic::In_W;
+    constexpr unsigned Out_W  = Cordic::Out_W;
+    constexpr int64_t  in_max = (int64_t(1) << (In_W - 1)) - 1;
+    constexpr size_t   length = 1U << 16;
+    constexpr unsigned runs   = 5;
+
+    const double in_scale  = double(Cordic::in_scale_factor);
+    const double out_scale = double(Cordic::out_scale_factor);
+    const double step      = Cordic::rotation / double(Cordic::q);
+
+    vector<ap_int<In_W>>  re_in(length), im_in(length);
+    vector<ap_int<Out_W>> re_out(length), im_out(length);
+    vector<uint32_t>      counters(length);
+
+    rcr::lcg rng;
+    for (size_t i = 0; i < length; i++) {
+        re_in[i]    = rng.uniform(-in_max, in_max);
+        im_in[i]    = rng.uniform(-in_max, in_max);
+        counters[i] = uint32_t(i % Cordic::max_length);
+    }
+
+    for (unsigned stages = 1; stages <= Cordic::nb_stages; stages++) {
+        double best_ns = numeric_limits<double>::infinity();
+        for (unsigned r = 0; r < runs; r++) {
+            const auto start = chrono::steady_clock::now();
+            for (size_t i = 0; i < length; i++) {
+                Cordic::cordic(re_in[i], im_in[i], counters[i], stages, re_out[i], im_out[i]);
+            }
+            const auto stop = chrono::steady_clock::now();
+
+            best_ns = min(best_ns, chrono::duration<double, nano>(stop - start).count() / double(length));
+        }
+
+        double signal = 0., noise = 0., max_error = 0., max_phase = 0.;
+        for (size_t i = 0; i < length; i++) {
+            const complex<double> x(re_in[i].to_double() / in_scale, im_in[i].to_double() / in_scale);
+            const complex<double> expected = x * polar(1., step * double(counters[i]));
+            const complex<double> obtained(Cordic::scale_cordic(re_out[i].to_double(), stages) / out_scale,
+                                           Cordic::scale_cordic(im_out[i].to_double(), stages) / out_scale);
+
+            const double error = abs(obtained - expected);
+            signal += norm(expected);
+            noise += error * error;
+            max_error = max(max_error, error);
+            if (abs(x) > 0.25 * double(1U << (Cordic::In_I - 1))) {
+                max_phase = max(max_phase, abs(arg(obtained / expected)));
+            }
+        }
+
+        printf("%3u %6u %5u %7u | %6u %10.2f %10.3e %10.3e %8.2f\n",
+               In_W, Cordic::nb_stages, Cordic::q, Cordic::divider, stages,
+               best_ns, max_error, max_phase, 10. * log10(signal / noise));
+    }
+}
+
+int main(int, char **) {
+    printf("%3s %6s %5s %7s | %6s %10s %10s %10s %8s\n",
+           "W", "stages", "q", "divider", "used", "ns/sample", "max_error", "max_phase", "SNR(dB)");
+
+    bench<CCordicRotateConstexpr<12, 3, 7, 32, 2>>();
+    bench<CCordicRotateConstexpr<16, 4, 7, 64, 2>>();
+    bench<CCordicRotateConstexpr<16, 4, 7, 64, 4>>();
+
+    return EXIT_SUCCESS;
+}